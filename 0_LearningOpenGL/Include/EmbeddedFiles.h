@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// 构建时嵌入可执行文件中的文件，由 Tools/EmbedShaders.py 生成 EmbeddedShaders.h/.cpp
+struct EmbeddedFile
+{
+    // 相对于工程目录，例如 "Shader/VertexShader.vert"
+    const char* path;
+    const char* data;
+    size_t size;
+};
+
+// 加载路径带有这个前缀时从嵌入的数据中读取，不访问文件系统，例如 EMBEDDED_PATH_PREFIX "Shader/VertexShader.vert"
+// ShaderPreprocessor 按相对路径解析 #include，被 include 的文件同样来自嵌入的数据
+#define EMBEDDED_PATH_PREFIX "embedded:"
+
+bool isEmbeddedPath(const std::string& path);
+// 带有前缀的加载路径
+std::string getEmbeddedPath(const EmbeddedFile& file);
+// path 需要带有前缀，找不到时返回 nullptr
+const EmbeddedFile* findEmbeddedFile(const std::string& path);
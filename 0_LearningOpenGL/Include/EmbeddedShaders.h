@@ -0,0 +1,23 @@
+// 由 Tools/EmbedShaders.py 根据 Shader/ 目录生成，不要手动修改
+#pragma once
+
+#include <cstddef>
+#include "EmbeddedFiles.h"
+
+namespace EmbeddedShaders
+{
+    extern const EmbeddedFile FallbackShader_frag;
+    extern const EmbeddedFile FallbackShader_vert;
+    extern const EmbeddedFile FragmentShader_frag;
+    extern const EmbeddedFile InstancedShader_frag;
+    extern const EmbeddedFile InstancedShader_vert;
+    extern const EmbeddedFile MeshLighting_glsl;
+    extern const EmbeddedFile MeshShader_frag;
+    extern const EmbeddedFile MeshShader_vert;
+    extern const EmbeddedFile QuantizedMeshShader_vert;
+    extern const EmbeddedFile VertexShader_vert;
+}
+
+// 全部嵌入的文件，供 findEmbeddedFile 按路径查找
+extern const EmbeddedFile* const kEmbeddedFiles[];
+extern const size_t kEmbeddedFileCount;
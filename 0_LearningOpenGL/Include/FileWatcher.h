@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+// 后台线程监视文件修改，Linux 下使用 inotify，其他平台定时比较修改时间
+// 调用方在帧边界比较版本号即可，不需要在渲染线程上访问文件系统
+class FileWatcher
+{
+public:
+    static FileWatcher& instance();
+    ~FileWatcher();
+
+    void watch(const std::string& path);
+    // 文件每被修改一次版本号加一，未监视的文件返回 0
+    unsigned int getVersion(const std::string& path);
+    // 任意被监视的文件修改时加一，用于快速判断是否需要逐个检查
+    unsigned int getGeneration() const { return generation; }
+private:
+    struct WatchedFile
+    {
+        unsigned int version;
+        long long modifiedTime;
+    };
+
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::unordered_map<std::string, WatchedFile> files;
+    std::thread thread;
+    std::atomic<bool> running{ false };
+    std::atomic<unsigned int> generation{ 0 };
+#ifdef __linux__
+    int inotifyFd = -1;
+    // inotify watch descriptor -> 目录
+    std::unordered_map<int, std::string> directories;
+#endif
+
+    FileWatcher() = default;
+    void run();
+    void pollModifiedTimes();
+    static long long getModifiedTime(const std::string& path);
+};
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <glad/glad.h>
+
+// glad 只生成了 GL 3.3 core 的函数，这里按需加载更高版本或扩展提供的函数
+// 使用前需要先检查 glExtensions 中对应的标志位
+
+// GL 4.1 / ARB_get_program_binary
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#define GL_PROGRAM_BINARY_FORMATS 0x87FF
+#endif
+typedef void (APIENTRYP PFNGLGETPROGRAMBINARYPROC)(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary);
+typedef void (APIENTRYP PFNGLPROGRAMBINARYPROC)(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+typedef void (APIENTRYP PFNGLPROGRAMPARAMETERIPROC)(GLuint program, GLenum pname, GLint value);
+extern PFNGLGETPROGRAMBINARYPROC glext_glGetProgramBinary;
+#define glGetProgramBinary glext_glGetProgramBinary
+extern PFNGLPROGRAMBINARYPROC glext_glProgramBinary;
+#define glProgramBinary glext_glProgramBinary
+extern PFNGLPROGRAMPARAMETERIPROC glext_glProgramParameteri;
+#define glProgramParameteri glext_glProgramParameteri
+
+// KHR_parallel_shader_compile / ARB_parallel_shader_compile
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)(GLuint count);
+extern PFNGLMAXSHADERCOMPILERTHREADSKHRPROC glext_glMaxShaderCompilerThreadsKHR;
+#define glMaxShaderCompilerThreadsKHR glext_glMaxShaderCompilerThreadsKHR
+
+// GL 4.3 / ARB_vertex_attrib_binding
+typedef void (APIENTRYP PFNGLBINDVERTEXBUFFERPROC)(GLuint bindingindex, GLuint buffer, GLintptr offset, GLsizei stride);
+typedef void (APIENTRYP PFNGLVERTEXATTRIBFORMATPROC)(GLuint attribindex, GLint size, GLenum type, GLboolean normalized, GLuint relativeoffset);
+typedef void (APIENTRYP PFNGLVERTEXATTRIBIFORMATPROC)(GLuint attribindex, GLint size, GLenum type, GLuint relativeoffset);
+typedef void (APIENTRYP PFNGLVERTEXATTRIBBINDINGPROC)(GLuint attribindex, GLuint bindingindex);
+typedef void (APIENTRYP PFNGLVERTEXBINDINGDIVISORPROC)(GLuint bindingindex, GLuint divisor);
+extern PFNGLBINDVERTEXBUFFERPROC glext_glBindVertexBuffer;
+#define glBindVertexBuffer glext_glBindVertexBuffer
+extern PFNGLVERTEXATTRIBFORMATPROC glext_glVertexAttribFormat;
+#define glVertexAttribFormat glext_glVertexAttribFormat
+extern PFNGLVERTEXATTRIBIFORMATPROC glext_glVertexAttribIFormat;
+#define glVertexAttribIFormat glext_glVertexAttribIFormat
+extern PFNGLVERTEXATTRIBBINDINGPROC glext_glVertexAttribBinding;
+#define glVertexAttribBinding glext_glVertexAttribBinding
+extern PFNGLVERTEXBINDINGDIVISORPROC glext_glVertexBindingDivisor;
+#define glVertexBindingDivisor glext_glVertexBindingDivisor
+
+// GL 4.1 / ARB_separate_shader_objects
+#ifndef GL_PROGRAM_SEPARABLE
+#define GL_VERTEX_SHADER_BIT 0x00000001
+#define GL_FRAGMENT_SHADER_BIT 0x00000002
+#define GL_ALL_SHADER_BITS 0xFFFFFFFF
+#define GL_PROGRAM_SEPARABLE 0x8258
+#define GL_ACTIVE_PROGRAM 0x8259
+#define GL_PROGRAM_PIPELINE_BINDING 0x825A
+#endif
+typedef void (APIENTRYP PFNGLGENPROGRAMPIPELINESPROC)(GLsizei n, GLuint* pipelines);
+typedef void (APIENTRYP PFNGLDELETEPROGRAMPIPELINESPROC)(GLsizei n, const GLuint* pipelines);
+typedef void (APIENTRYP PFNGLBINDPROGRAMPIPELINEPROC)(GLuint pipeline);
+typedef void (APIENTRYP PFNGLUSEPROGRAMSTAGESPROC)(GLuint pipeline, GLbitfield stages, GLuint program);
+typedef void (APIENTRYP PFNGLVALIDATEPROGRAMPIPELINEPROC)(GLuint pipeline);
+typedef void (APIENTRYP PFNGLGETPROGRAMPIPELINEIVPROC)(GLuint pipeline, GLenum pname, GLint* params);
+typedef void (APIENTRYP PFNGLGETPROGRAMPIPELINEINFOLOGPROC)(GLuint pipeline, GLsizei bufSize, GLsizei* length, GLchar* infoLog);
+typedef void (APIENTRYP PFNGLPROGRAMUNIFORM1IPROC)(GLuint program, GLint location, GLint v0);
+typedef void (APIENTRYP PFNGLPROGRAMUNIFORM1FPROC)(GLuint program, GLint location, GLfloat v0);
+extern PFNGLGENPROGRAMPIPELINESPROC glext_glGenProgramPipelines;
+#define glGenProgramPipelines glext_glGenProgramPipelines
+extern PFNGLDELETEPROGRAMPIPELINESPROC glext_glDeleteProgramPipelines;
+#define glDeleteProgramPipelines glext_glDeleteProgramPipelines
+extern PFNGLBINDPROGRAMPIPELINEPROC glext_glBindProgramPipeline;
+#define glBindProgramPipeline glext_glBindProgramPipeline
+extern PFNGLUSEPROGRAMSTAGESPROC glext_glUseProgramStages;
+#define glUseProgramStages glext_glUseProgramStages
+extern PFNGLVALIDATEPROGRAMPIPELINEPROC glext_glValidateProgramPipeline;
+#define glValidateProgramPipeline glext_glValidateProgramPipeline
+extern PFNGLGETPROGRAMPIPELINEIVPROC glext_glGetProgramPipelineiv;
+#define glGetProgramPipelineiv glext_glGetProgramPipelineiv
+extern PFNGLGETPROGRAMPIPELINEINFOLOGPROC glext_glGetProgramPipelineInfoLog;
+#define glGetProgramPipelineInfoLog glext_glGetProgramPipelineInfoLog
+extern PFNGLPROGRAMUNIFORM1IPROC glext_glProgramUniform1i;
+#define glProgramUniform1i glext_glProgramUniform1i
+extern PFNGLPROGRAMUNIFORM1FPROC glext_glProgramUniform1f;
+#define glProgramUniform1f glext_glProgramUniform1f
+
+// GL 4.6 / ARB_gl_spirv（glShaderBinary 属于 GL 4.1 / ARB_ES2_compatibility）
+#ifndef GL_SHADER_BINARY_FORMAT_SPIR_V
+#define GL_SHADER_BINARY_FORMAT_SPIR_V 0x9551
+#define GL_SPIR_V_BINARY 0x9552
+#endif
+typedef void (APIENTRYP PFNGLSHADERBINARYPROC)(GLsizei count, const GLuint* shaders, GLenum binaryformat, const void* binary, GLsizei length);
+typedef void (APIENTRYP PFNGLSPECIALIZESHADERPROC)(GLuint shader, const GLchar* pEntryPoint, GLuint numSpecializationConstants, const GLuint* pConstantIndex, const GLuint* pConstantValue);
+extern PFNGLSHADERBINARYPROC glext_glShaderBinary;
+#define glShaderBinary glext_glShaderBinary
+extern PFNGLSPECIALIZESHADERPROC glext_glSpecializeShader;
+#define glSpecializeShader glext_glSpecializeShader
+
+// GL 4.4 / ARB_buffer_storage
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#define GL_MAP_COHERENT_BIT 0x0080
+#define GL_DYNAMIC_STORAGE_BIT 0x0100
+#define GL_CLIENT_STORAGE_BIT 0x0200
+#endif
+typedef void (APIENTRYP PFNGLBUFFERSTORAGEPROC)(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+extern PFNGLBUFFERSTORAGEPROC glext_glBufferStorage;
+#define glBufferStorage glext_glBufferStorage
+
+// GL 4.3 / ARB_multi_draw_indirect（GL_DRAW_INDIRECT_BUFFER 属于 GL 4.0 / ARB_draw_indirect）
+// 命令中的 baseInstance 属于 GL 4.2 / ARB_base_instance，GL 4.3 中一定可用
+#ifndef GL_DRAW_INDIRECT_BUFFER
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#define GL_DRAW_INDIRECT_BUFFER_BINDING 0x8F43
+#endif
+typedef void (APIENTRYP PFNGLMULTIDRAWELEMENTSINDIRECTPROC)(GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride);
+extern PFNGLMULTIDRAWELEMENTSINDIRECTPROC glext_glMultiDrawElementsIndirect;
+#define glMultiDrawElementsIndirect glext_glMultiDrawElementsIndirect
+
+struct GLExtensions
+{
+    bool programBinary = false;
+    bool parallelShaderCompile = false;
+    bool vertexAttribBinding = false;
+    bool separateShaderObjects = false;
+    bool spirv = false;
+    bool bufferStorage = false;
+    bool multiDrawIndirect = false;
+};
+
+extern GLExtensions glExtensions;
+
+// 在 gladLoadGLLoader 成功之后调用
+void loadGLExtensions(GLADloadproc load);
+bool hasGLExtension(const char* name);
+bool isGLVersionAtLeast(int major, int minor);
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <glad/glad.h>
+
+// 渲染状态缓存：记录当前的 GL 状态，与缓存相同的调用直接丢弃，不再进入驱动
+// 所有会改变这些状态的调用都需要经过这里，否则缓存与实际状态不一致；
+// 直接调用了 GL（例如第三方库）之后需要调用 invalidate
+// 删除对象也要经过这里，否则 id 被复用后会误判为重复调用
+class GLState
+{
+public:
+    // 缓存中的未知状态，第一次调用一定会提交
+    static const unsigned int kUnknown = 0xFFFFFFFFu;
+
+    static GLState& instance();
+
+    void useProgram(unsigned int program);
+    // glUseProgram 绑定的 program 优先于 pipeline，绑定 pipeline 时会先把 program 置为 0
+    void bindProgramPipeline(unsigned int pipeline);
+    void bindVertexArray(unsigned int vertexArray);
+    void bindBuffer(GLenum target, unsigned int buffer);
+    void bindBufferRange(GLenum target, unsigned int index, unsigned int buffer, GLintptr offset, GLsizeiptr size);
+    // 只跟踪 GL_BLEND、GL_DEPTH_TEST、GL_CULL_FACE，其余 capability 直接调用
+    void setEnabled(GLenum capability, bool enabled);
+    void blendFunc(GLenum sourceFactor, GLenum destinationFactor);
+    void depthFunc(GLenum func);
+    void cullFace(GLenum mode);
+    void viewport(int x, int y, int width, int height);
+
+    void deleteProgram(unsigned int program);
+    void deleteProgramPipeline(unsigned int pipeline);
+    void deleteVertexArray(unsigned int vertexArray);
+    void deleteBuffer(unsigned int buffer);
+
+    unsigned int getCurrentProgram() const { return program; }
+    void invalidate();
+
+    // 实际提交给驱动的调用次数与被过滤掉的次数
+    unsigned int getIssuedCount() const { return issued; }
+    unsigned int getSkippedCount() const { return skipped; }
+    void resetCounters();
+    void printStats() const;
+private:
+    enum BufferTarget { ArrayBuffer, ElementArrayBuffer, UniformBuffer, CopyReadBuffer, CopyWriteBuffer, DrawIndirectBuffer, BufferTargetCount };
+    enum Capability { Blend, DepthTest, CullFace, CapabilityCount };
+    static const int kMaxUniformBufferBindings = 16;
+
+    struct BufferRange
+    {
+        unsigned int buffer;
+        GLintptr offset;
+        GLsizeiptr size;
+    };
+
+    unsigned int program;
+    unsigned int programPipeline;
+    unsigned int vertexArray;
+    unsigned int buffers[BufferTargetCount];
+    BufferRange uniformRanges[kMaxUniformBufferBindings];
+    int capabilities[CapabilityCount]; // -1 未知，0 关闭，1 开启
+    unsigned int blend[2];
+    unsigned int depth;
+    unsigned int cull;
+    int viewportRect[4];
+
+    unsigned int issued = 0;
+    unsigned int skipped = 0;
+
+    GLState();
+    bool filter(bool redundant);
+    static int getBufferTarget(GLenum target);
+    static int getCapability(GLenum capability);
+};
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <vector>
+#include "MeshOptimizer.h"
+#include "OffsetAllocator.h"
+
+// 一个 mesh 在共用 buffer 中的位置，绘制时用 baseVertex 和 firstIndex 定位
+struct GeometryRange
+{
+    unsigned int vertexBuffer;
+    unsigned int indexBuffer;
+    // 索引是相对于 mesh 自己的顶点的，绘制时加上 baseVertex
+    unsigned int baseVertex;
+    unsigned int vertexCount;
+    // 以索引为单位，字节偏移为 firstIndex * getIndexSize()
+    unsigned int firstIndex;
+    unsigned int indexCount;
+    GLenum indexType;
+
+    size_t getIndexSize() const { return indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(unsigned int); }
+};
+
+// 低 20 位为槽位的下标，高 12 位为槽位的 generation；槽位释放时 generation 加一，
+// 已经 free 的旧句柄与复用该槽位的新 mesh 的句柄不同，isValid 返回 false
+typedef unsigned int MeshHandle;
+const MeshHandle kInvalidMesh = 0xFFFFFFFFu;
+
+// 所有静态 mesh 的顶点和索引放在少数几个大 buffer 中，不再每个 mesh 一对 VBO/EBO：
+// - 相同 stride 的顶点共用顶点池，按顶点分配，偏移就是 baseVertex，同一格式的 mesh 绘制时不需要切换顶点缓冲
+// - 索引共用索引池，按 4 字节分配，16 位和 32 位索引可以混放
+// - 池满时新建一个池；defragment 用 glCopyBufferSubData 把存活的 mesh 紧凑地搬到新 buffer 中
+// 返回的 MeshHandle 在 defragment 后仍然有效，但 buffer 和偏移会变化，每次绘制前通过 get 取得
+class GeometryBuffer
+{
+public:
+    static GeometryBuffer& instance();
+
+    // indices 的类型为 GL_UNSIGNED_SHORT 或 GL_UNSIGNED_INT
+    MeshHandle upload(const void* vertices, unsigned int vertexCount, unsigned int stride,
+        const void* indices, unsigned int indexCount, GLenum indexType);
+    template <class Vertex>
+    MeshHandle upload(const std::vector<Vertex>& vertices, const IndexData& indexData)
+    {
+        return upload(vertices.data(), (unsigned int)vertices.size(), sizeof(Vertex),
+            indexData.bytes.data(), (unsigned int)indexData.count, indexData.type);
+    }
+    void free(MeshHandle mesh);
+    bool isValid(MeshHandle mesh) const
+    {
+        unsigned int index = mesh & kIndexMask;
+        return index < meshes.size() && meshes[index].live && meshes[index].generation == mesh >> kIndexBits;
+    }
+    // 返回拷贝：upload 可能让 meshes 重新分配，引用会失效；mesh 需要有效
+    GeometryRange get(MeshHandle mesh) const { return meshes[mesh & kIndexMask].range; }
+
+    // 需要先绑定以 range.vertexBuffer/indexBuffer 为数据源的 VAO
+    void draw(MeshHandle mesh) const;
+    // 只画 mesh 中的一段索引，firstIndex 相对于 mesh 的第一个索引
+    void drawRange(MeshHandle mesh, unsigned int firstIndex, unsigned int indexCount) const;
+
+    // 整理所有有空洞的池，返回搬移的 mesh 数
+    unsigned int defragment();
+    void printStats() const;
+    void release();
+private:
+    struct Pool
+    {
+        unsigned int buffer;
+        // 顶点池的顶点大小；索引池为 0
+        unsigned int stride;
+        // 顶点池以顶点为单位，索引池以 4 字节为单位
+        OffsetAllocator allocator;
+    };
+
+    static const unsigned int kIndexBits = 20;
+    static const unsigned int kIndexMask = (1u << kIndexBits) - 1;
+    static const unsigned int kGenerationMask = 0xFFFFFFFFu >> kIndexBits;
+    // 下标全为 1 的槽位不使用，任何句柄都不会等于 kInvalidMesh
+    static const unsigned int kMaxMeshes = kIndexMask;
+
+    struct Mesh
+    {
+        bool live;
+        unsigned int generation;
+        unsigned int vertexPool;
+        unsigned int indexPool;
+        OffsetAllocation vertexAllocation;
+        OffsetAllocation indexAllocation;
+        GeometryRange range;
+    };
+
+    std::vector<Pool> pools;
+    std::vector<Mesh> meshes;
+    // 空闲槽位的下标
+    std::vector<unsigned int> freeMeshes;
+
+    GeometryBuffer() = default;
+    // 在已有的池中分配，都放不下时新建一个池；返回池的下标
+    unsigned int allocate(unsigned int stride, unsigned int size, OffsetAllocation& allocation);
+    void updateRange(Mesh& mesh);
+};
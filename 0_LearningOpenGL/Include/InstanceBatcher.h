@@ -0,0 +1,70 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "GeometryBuffer.h"
+#include "Shader.h"
+#include "StreamBuffer.h"
+#include "VertexLayout.h"
+
+// 实例化绘制的 CPU 端收集器：每帧调用 add 提交 (mesh, shader, 实例数据)，
+// flush 时按 (shader, mesh, 实例格式) 分组，每组的实例数据连续写入 StreamBuffer，
+// 每组只发一次 glDrawElementsInstancedBaseVertex，不再每个实例一次绘制加一次 uniform 更新
+class InstanceBatcher
+{
+public:
+    explicit InstanceBatcher(StreamBuffer& stream);
+
+    // meshLayout 为 mesh 顶点的格式，instanceLayout 为实例数据的格式，instance 的大小为 instanceLayout.stride
+    void add(MeshHandle mesh, const VertexLayout& meshLayout, Shader& shader, const VertexLayout& instanceLayout, const void* instance);
+    template <class Instance>
+    void add(MeshHandle mesh, const VertexLayout& meshLayout, Shader& shader, const VertexLayout& instanceLayout, const Instance& instance)
+    {
+        add(mesh, meshLayout, shader, instanceLayout, static_cast<const void*>(&instance));
+    }
+    // 在 StreamBuffer 的 beginFrame 和 endFrame 之间调用
+    void flush();
+
+    void printStats() const;
+private:
+    // 同一个 Shader 对象热重载后 program 会变，用对象地址而不是 program 分组
+    struct BatchKey
+    {
+        MeshHandle mesh;
+        const VertexLayout* meshLayout;
+        const Shader* shader;
+        const VertexLayout* instanceLayout;
+
+        bool operator==(const BatchKey& other) const
+        {
+            return mesh == other.mesh && meshLayout == other.meshLayout && shader == other.shader && instanceLayout == other.instanceLayout;
+        }
+    };
+    struct BatchKeyHash
+    {
+        size_t operator()(const BatchKey& key) const;
+    };
+
+    struct Batch
+    {
+        MeshHandle mesh;
+        const VertexLayout* meshLayout;
+        Shader* shader;
+        const VertexLayout* instanceLayout;
+        unsigned int instanceCount;
+        std::vector<char> instances;
+        StreamBufferRange range;
+    };
+
+    StreamBuffer& stream;
+    // 批次在各帧之间复用，实例数组的内存不会反复分配；某一帧没有用到的批次在 flush 时删除
+    std::vector<Batch> batches;
+    std::unordered_map<BatchKey, size_t, BatchKeyHash> batchIndices;
+    std::vector<size_t> drawOrder;
+
+    unsigned int frames = 0;
+    unsigned int instances = 0;
+    unsigned int draws = 0;
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// 只读加载文件：磁盘文件用内存映射（Windows 下 CreateFileMapping，其他平台 mmap），
+// 带有 EMBEDDED_PATH_PREFIX 的路径直接指向嵌入的数据，两种情况都不经过中间缓冲
+// data() 在 close 或析构之前有效，可以直接交给 glShaderSource/glShaderBinary/glProgramBinary
+// Windows 下映射中的文件不能被改写，用完应尽快 close，否则会挡住编辑器保存（热重载）
+class MappedFile
+{
+public:
+    // 所有 MappedFile 的累计数据，用于对比加载耗时和拷贝量
+    struct Stats
+    {
+        unsigned int files = 0;
+        size_t bytesMapped = 0;
+        size_t bytesCopied = 0;
+        double milliseconds = 0.0;
+    };
+
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other);
+    MappedFile& operator=(MappedFile&& other);
+
+    // 失败时输出 ERROR::FILE::OPEN_FAILED 并返回 false，reportError 为 false 时静默（用于探测可选文件）
+    bool open(const std::string& path, bool reportError = true);
+    void close();
+    bool isOpen() const { return opened; }
+    const char* data() const { return begin; }
+    size_t size() const { return length; }
+    // 需要长期持有内容时拷贝一份，拷贝量计入统计；text 为 true 时 \r\n 转换为 \n
+    void copyTo(std::string& content, bool text = false) const;
+
+    static const Stats& getStats() { return stats; }
+    static void printStats();
+private:
+    const char* begin = nullptr;
+    size_t length = 0;
+    bool opened = false;
+    // 是否是自己映射的内存（嵌入的数据和空文件不需要 unmap）
+    bool mapped = false;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+
+    static Stats stats;
+
+    bool map(const std::string& path);
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+// 最小化的向量/矩阵类型，内存布局与 GLSL 一致，可以直接传给 glUniform* 和顶点缓冲
+// 矩阵按列主序存储
+struct Vec2
+{
+    float x, y;
+};
+
+struct Vec3
+{
+    float x, y, z;
+};
+
+struct Vec4
+{
+    float x, y, z, w;
+};
+
+struct Mat3
+{
+    float m[9];
+};
+
+struct Mat4
+{
+    float m[16];
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 索引缓冲优化，推荐的顺序与 optimizeMesh 相同：
+// 1. optimizeVertexCache：按后变换顶点缓存重排三角形（Forsyth 线性时间算法）
+// 2. optimizeOverdraw：在不明显破坏缓存命中的前提下，按簇重排三角形，朝外的簇先画，减少 overdraw
+// 3. optimizeVertexFetch：按第一次被引用的顺序重排顶点，顶点拉取时访问的内存连续；没有被引用的顶点被去掉
+// 所有函数只处理三角形列表
+
+// ACMR：每个三角形平均的缓存未命中数（0.5 ~ 3，越小越好）
+// ATVR：未命中数与被引用顶点数之比（1 为理想值）
+struct VertexCacheStats
+{
+    float acmr;
+    float atvr;
+};
+
+// 用 FIFO 缓存模拟后变换缓存，cacheSize 为常见硬件的大小
+VertexCacheStats analyzeVertexCache(const unsigned int* indices, size_t indexCount, size_t vertexCount, unsigned int cacheSize = 16);
+
+// destination 可以与 indices 相同
+void optimizeVertexCache(unsigned int* destination, const unsigned int* indices, size_t indexCount, size_t vertexCount);
+// indices 应当已经过 optimizeVertexCache；positions 指向第一个顶点的 float[3]，相邻顶点相隔 positionStride 字节
+// threshold 为允许的 ACMR 变差比例，1.05 表示最多变差 5%
+void optimizeOverdraw(unsigned int* destination, const unsigned int* indices, size_t indexCount,
+    const void* positions, size_t vertexCount, size_t positionStride, float threshold = 1.05f);
+// 生成重排表：remap[旧顶点] = 新顶点，未被引用的顶点为 ~0u；返回新的顶点数
+size_t optimizeVertexFetchRemap(unsigned int* remap, const unsigned int* indices, size_t indexCount, size_t vertexCount);
+// 按重排表重写索引和顶点，destination 不能与 vertices 相同
+void remapIndexBuffer(unsigned int* indices, size_t indexCount, const unsigned int* remap);
+void remapVertexBuffer(void* destination, const void* vertices, size_t vertexCount, size_t vertexSize, const unsigned int* remap);
+
+// 依次执行以上三个 pass，并输出优化前后的 ACMR/ATVR；返回新的顶点数，vertices 会被原地重排
+size_t optimizeMesh(void* vertices, size_t vertexCount, size_t vertexSize, size_t positionOffset, std::vector<unsigned int>& indices);
+
+// Vertex 需要有 float position[3] 成员
+template <class Vertex>
+void optimizeMesh(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices)
+{
+    vertices.resize(optimizeMesh(vertices.data(), vertices.size(), sizeof(Vertex), offsetof(Vertex, position), indices));
+}
+
+// 上传用的索引数据：顶点数小于 65536 时使用 16 位索引，显存和索引拉取减半
+struct IndexData
+{
+    GLenum type;
+    size_t count;
+    std::vector<char> bytes;
+
+    // 字节偏移 = 索引偏移 * getIndexSize()
+    size_t getIndexSize() const { return type == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(unsigned int); }
+};
+
+IndexData packIndices(const std::vector<unsigned int>& indices, size_t vertexCount);
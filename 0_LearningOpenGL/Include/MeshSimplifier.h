@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// 基于二次误差度量（QEM）的网格简化：反复把一条边的一个端点合并到另一个端点
+// 只合并到已有的顶点，不生成新顶点，简化后的索引仍然引用原来的顶点缓冲，所有 LOD 可以共用同一个顶点缓冲
+// 属性保持：合并的代价中加入两端点属性（颜色、法线等）的差；只在一个三角形中出现的边（网格边界、UV/法线接缝）
+// 所在的顶点只能沿边界合并，并加入垂直于边界的平面，避免边界收缩
+struct SimplifySettings
+{
+    // 属性在顶点中的偏移和 float 个数，attributeCount 为 0 时不考虑属性
+    size_t attributeOffset = 0;
+    size_t attributeCount = 0;
+    float attributeWeight = 1.0f;
+};
+
+// 简化到不超过 targetIndexCount 个索引，或者位置误差将超过 targetError（与位置同单位）时停止；属性误差只影响合并顺序
+// 返回新的索引数，destination 可以与 indices 相同；resultError 为实际的最大误差
+size_t simplifyMesh(unsigned int* destination, const unsigned int* indices, size_t indexCount,
+    const void* vertices, size_t vertexCount, size_t vertexSize, size_t positionOffset,
+    size_t targetIndexCount, float targetError, const SimplifySettings& settings, float* resultError);
+
+// 一级 LOD 在共用索引缓冲中的范围，error 为与原始网格的最大误差（与位置同单位）
+struct MeshLod
+{
+    unsigned int indexOffset;
+    unsigned int indexCount;
+    float error;
+};
+
+struct LodSettings : SimplifySettings
+{
+    int maxLods = 5;
+    // 每一级的目标三角形数与上一级之比
+    float reduction = 0.5f;
+    // 允许的最大误差，相对于包围盒对角线
+    float maxError = 0.05f;
+};
+
+// 所有 LOD 的索引依次存放在 indices 中，lods[0] 为原始网格
+struct LodChain
+{
+    std::vector<unsigned int> indices;
+    std::vector<MeshLod> lods;
+};
+
+// 每一级从上一级简化得到，并各自做顶点缓存优化；某一级无法再明显减少三角形时停止
+LodChain buildLodChain(const unsigned int* indices, size_t indexCount, const void* vertices, size_t vertexCount,
+    size_t vertexSize, size_t positionOffset, const LodSettings& settings);
+
+// Vertex 需要有 float position[3] 成员
+template <class Vertex>
+LodChain buildLodChain(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+    const LodSettings& settings = LodSettings())
+{
+    return buildLodChain(indices.data(), indices.size(), vertices.data(), vertices.size(), sizeof(Vertex),
+        offsetof(Vertex, position), settings);
+}
+
+// 一个单位长度投影到屏幕上的像素数；透视投影下与距离成反比，fovY 为弧度
+float getPixelsPerUnit(float distance, float fovY, float screenHeight);
+// 投影误差不超过 pixelThreshold 像素的最粗糙的一级
+size_t selectLod(const std::vector<MeshLod>& lods, float pixelsPerUnit, float pixelThreshold = 1.0f);
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <vector>
+#include "MathTypes.h"
+
+// meshlet：把三角形列表按顺序切成不超过 64 个顶点、124 个三角形的小簇，每个簇带有包围球和法线锥
+// 簇按输入的三角形顺序连续划分，每个簇就是索引缓冲中连续的一段，不需要额外的索引数据；
+// 输入最好已经过 optimizeVertexCache，相邻三角形共享顶点，簇更紧凑
+// 每帧在 CPU 上剔除不可见的簇，可见的簇合并成若干段，用一次 glMultiDrawElements 提交
+
+struct Meshlet
+{
+    // 在输入索引中的范围
+    unsigned int indexOffset;
+    unsigned int indexCount;
+    unsigned int vertexCount;
+
+    // 包围球
+    float center[3];
+    float radius;
+    // 法线锥：所有三角形的法线与 coneAxis 的夹角都在锥内；从 coneApex 看过去满足
+    // dot(normalize(coneApex - camera), coneAxis) >= coneCutoff 时整个簇都是背面
+    float coneApex[3];
+    float coneAxis[3];
+    float coneCutoff;
+};
+
+const size_t kMeshletMaxVertices = 64;
+const size_t kMeshletMaxTriangles = 124;
+
+// positions 的访问方式与 optimizeOverdraw 相同
+std::vector<Meshlet> buildMeshlets(const unsigned int* indices, size_t indexCount, const void* vertices, size_t vertexCount,
+    size_t vertexSize, size_t positionOffset, size_t maxVertices = kMeshletMaxVertices, size_t maxTriangles = kMeshletMaxTriangles);
+
+// Vertex 需要有 float position[3] 成员
+template <class Vertex>
+std::vector<Meshlet> buildMeshlets(const std::vector<Vertex>& vertices, const unsigned int* indices, size_t indexCount)
+{
+    return buildMeshlets(indices, indexCount, vertices.data(), vertices.size(), sizeof(Vertex), offsetof(Vertex, position));
+}
+
+// 剔除使用的视图信息，坐标与顶点位置在同一空间
+struct MeshletCullView
+{
+    // 视锥的 6 个平面，xyz 为指向内部的单位法线
+    Vec4 planes[6];
+    bool perspective;
+    // 透视投影用相机位置，正交投影用观察方向
+    Vec3 cameraPosition;
+    Vec3 viewDirection;
+    // 法线锥剔除只在开启 GL_CULL_FACE（剔除背面）时成立，否则背面也会被画出来
+    bool coneCulling;
+};
+
+// 从列主序的 viewProjection 矩阵提取视锥平面
+MeshletCullView makePerspectiveCullView(const Mat4& viewProjection, const Vec3& cameraPosition, bool coneCulling);
+MeshletCullView makeOrthographicCullView(const Mat4& viewProjection, const Vec3& viewDirection, bool coneCulling);
+
+// 累计的剔除统计；frames 和 drawRanges 由调用者在每帧提交后累加
+struct MeshletCullStats
+{
+    size_t frames = 0;
+    size_t meshlets = 0;
+    size_t visibleMeshlets = 0;
+    size_t frustumCulled = 0;
+    size_t coneCulled = 0;
+    size_t trianglesSubmitted = 0;
+    size_t trianglesCulled = 0;
+    size_t drawRanges = 0;
+};
+
+void printMeshletCullStats(const MeshletCullStats& stats);
+
+// 可见簇合并后的绘制列表，索引相邻的簇合并成一段
+class MeshletDrawList
+{
+public:
+    void clear();
+    // indexOffset 为在索引缓冲中的位置（以索引为单位）
+    void add(unsigned int indexOffset, unsigned int indexCount);
+    bool isEmpty() const { return counts.empty(); }
+    size_t getRangeCount() const { return counts.size(); }
+    // 当前 VAO 绑定的索引缓冲中，每个索引占 indexSize 字节；baseVertex 为共用顶点缓冲中 mesh 的起点
+    void draw(GLenum indexType, size_t indexSize, int baseVertex = 0);
+private:
+    std::vector<unsigned int> firsts;
+    std::vector<GLsizei> counts;
+    std::vector<const void*> offsets;
+    std::vector<GLint> baseVertices;
+};
+
+// 剔除 meshlets 中不可见的簇，可见的簇加入 drawList；baseIndex 为 meshlets 所在的索引段在索引缓冲中的起点
+void cullMeshlets(const std::vector<Meshlet>& meshlets, const MeshletCullView& view, unsigned int baseIndex,
+    MeshletDrawList& drawList, MeshletCullStats* stats);
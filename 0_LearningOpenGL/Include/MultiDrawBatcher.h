@@ -0,0 +1,64 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <vector>
+#include "GeometryBuffer.h"
+#include "Shader.h"
+#include "StreamBuffer.h"
+#include "VertexLayout.h"
+
+// glMultiDrawElementsIndirect 的命令格式
+struct DrawElementsIndirectCommand
+{
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint baseVertex;
+    GLuint baseInstance;
+};
+
+// 把共用 GeometryBuffer 的静态物体合并成一次 glMultiDrawElementsIndirect：
+// 每个物体写入一条命令，每个物体的数据（变换、颜色等）作为 divisor 为 1 的实例属性，
+// 命令的 baseInstance 为物体的下标，shader 中直接读到自己的那一份，不需要 gl_DrawID 或 uniform
+// GL 4.3 以下没有 MDI，退化为逐个物体的 glDrawElementsBaseVertex，每次把实例属性的起点移到该物体的数据，
+// 同一个场景在 3.3 core 上也能画出来
+class MultiDrawBatcher
+{
+public:
+    explicit MultiDrawBatcher(StreamBuffer& stream);
+
+    // 一批物体共用 meshLayout、shader 和物体数据的格式 drawLayout
+    void begin(const VertexLayout& meshLayout, Shader& shader, const VertexLayout& drawLayout);
+    // drawData 的大小为 drawLayout.stride
+    void add(MeshHandle mesh, const void* drawData);
+    template <class DrawData>
+    void add(MeshHandle mesh, const DrawData& drawData)
+    {
+        add(mesh, static_cast<const void*>(&drawData));
+    }
+    // 在 StreamBuffer 的 beginFrame 和 endFrame 之间调用
+    void submit();
+
+    void printStats() const;
+private:
+    struct Draw
+    {
+        MeshHandle mesh;
+        // 不同池或不同索引类型的 mesh 不能放进同一次 MDI
+        unsigned int vertexBuffer;
+        unsigned int indexBuffer;
+        GLenum indexType;
+    };
+
+    StreamBuffer& stream;
+    const VertexLayout* meshLayout = nullptr;
+    Shader* shader = nullptr;
+    const VertexLayout* drawLayout = nullptr;
+    std::vector<Draw> draws;
+    std::vector<char> drawData;
+    std::vector<size_t> drawOrder;
+
+    unsigned int frames = 0;
+    unsigned int objects = 0;
+    unsigned int calls = 0;
+};
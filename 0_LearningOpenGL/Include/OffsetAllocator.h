@@ -0,0 +1,41 @@
+#pragma once
+
+#include <map>
+
+// 一段已分配的区间，单位由使用者决定（顶点、字节等）
+struct OffsetAllocation
+{
+    unsigned int offset;
+    unsigned int size;
+
+    bool isValid() const { return size > 0; }
+};
+
+// 在 [0, capacity) 上分配连续区间，只管理偏移，不持有内存，可以用来划分一块大的 GPU buffer
+// 空闲块同时按偏移和大小索引：分配时取能放下的最小空闲块（best fit），释放时与相邻的空闲块合并
+class OffsetAllocator
+{
+public:
+    explicit OffsetAllocator(unsigned int capacity = 0);
+
+    // 清空所有分配
+    void reset(unsigned int capacity);
+    // 空间不足时返回 size 为 0 的区间
+    OffsetAllocation allocate(unsigned int size);
+    void free(const OffsetAllocation& allocation);
+
+    unsigned int getCapacity() const { return capacity; }
+    unsigned int getUsed() const { return used; }
+    unsigned int getFreeBlockCount() const { return (unsigned int)freeByOffset.size(); }
+    unsigned int getLargestFreeBlock() const { return freeBySize.empty() ? 0 : freeBySize.rbegin()->first; }
+private:
+    unsigned int capacity = 0;
+    unsigned int used = 0;
+    // offset -> size
+    std::map<unsigned int, unsigned int> freeByOffset;
+    // size -> offset
+    std::multimap<unsigned int, unsigned int> freeBySize;
+
+    void insertFree(unsigned int offset, unsigned int size);
+    void eraseFree(unsigned int offset, unsigned int size);
+};
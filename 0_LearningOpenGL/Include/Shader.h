@@ -5,21 +5,126 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <memory>
+#include <vector>
+#include "EmbeddedFiles.h"
+#include "MappedFile.h"
+#include "StringHash.h"
+#include "UniformTable.h"
+
+// 通过 glGetActiveAttrib 反射得到的顶点输入
+struct ShaderAttribute
+{
+    std::string name;
+    uint32_t hash;
+    int location;
+    GLenum type;
+};
+
+// 特化常量：SPIR-V 路径下由 glSpecializeShader 设置，GLSL 路径下以 "#define NAME VALUE" 插入
+// shader 中在 #ifdef GL_SPIRV 里声明 layout (constant_id = ID) const int NAME = 默认值;
+// 之后用普通的 if 判断，两条路径得到相同的结果（GLSL 编译器同样会去掉不会执行的分支）
+struct SpecializationConstant
+{
+    std::string name;
+    unsigned int id;
+    int value;
+};
+
+// 枚举 program 的 active 顶点输入（按 location 排序），并计算名字和 location 的签名
+void reflectShaderAttributes(unsigned int program, std::vector<ShaderAttribute>& attributes, uint64_t& signature);
 
 class Shader
 {
+    friend class ShaderBatch;
 public:
-    unsigned int shaderProgram;
+    unsigned int shaderProgram = 0;
 
-    Shader(const char* vertexPath, const char* fragmentPath);
+    // 同步加载：编译并 link 完成后才返回
+    // defines 为插入到 #version 之后的宏定义，每行一个 "#define NAME VALUE"
+    // 支持 ARB_gl_spirv 且离线生成了 "<path>.spv" 时直接加载 SPIR-V，否则编译 GLSL 源码
+    Shader(const char* vertexPath, const char* fragmentPath, const std::string& defines = "",
+        const std::vector<SpecializationConstant>& constants = {});
+    // 使用构建时嵌入的源码（EmbeddedShaders.h），不访问文件系统，也不依赖工作目录
+    Shader(const EmbeddedFile& vertex, const EmbeddedFile& fragment, const std::string& defines = "",
+        const std::vector<SpecializationConstant>& constants = {});
     void release();
+    // 异步编译的 program 第一次被使用时才查询编译/link 状态（可能阻塞）
     void use();
+    // 非阻塞地查询 program 是否可用，不支持 KHR_parallel_shader_compile 时只能由 ShaderBatch::poll 收尾
+    bool isReady();
+    bool isFailed() const { return state == State::Failed; }
+    // 监视源文件，修改后在 update 中后台重新编译；嵌入的源码不会变化，不需要监视
+    void enableHotReload();
+    // 在帧边界调用：新的 program link 成功后才替换 shaderProgram，失败时保留旧的 program
+    // 没有 KHR_parallel_shader_compile 时，检测到修改的那一帧只提交编译，之后的帧才阻塞收尾；
+    // canFinish 为 false 时本次不阻塞，返回值表示本次是否阻塞收尾了 program
+    bool update(bool canFinish = true);
     // uniform
-    void setBool(const std::string& name, bool value) const;
-    void setInt(const std::string& name, int value) const;
-    void setFloat(const std::string& name, float value) const;
+    // 名字为字面量时在编译期完成哈希，查表得到 link 时缓存的 location
+    int getUniformLocation(HashedString name) const;
+    // program 每次 link 成功（包括热重载）都会变化，0 表示尚未 link
+    unsigned int getLinkStamp() const { return linkStamp; }
+    // active 顶点输入，按 location 排序
+    const std::vector<ShaderAttribute>& getAttributes() const { return attributes; }
+    // 顶点输入名字和 location 的哈希，相同的两个 program 可以共用同一个 VAO
+    uint64_t getAttributeSignature() const { return attributeSignature; }
+    void setBool(HashedString name, bool value) const;
+    void setInt(HashedString name, int value) const;
+    void setFloat(HashedString name, float value) const;
 private:
+    // Compiling: 源码已读取，等待提交编译；Linking: 编译和 link 已提交，状态尚未查询
+    enum class State { Compiling, Linking, Ready, Failed };
+
+    UniformTable uniforms;
+    std::vector<ShaderAttribute> attributes;
+    uint64_t attributeSignature = 0;
+    State state = State::Compiling;
+    unsigned int linkStamp = 0;
+    std::string vertexPath;
+    std::string fragmentPath;
+    std::string defines;
+    std::vector<SpecializationConstant> constants;
+    std::string vertexCode;
+    std::string fragmentCode;
+    // 离线编译的 SPIR-V，直接映射文件交给 glShaderBinary，没有打开时走 GLSL
+    MappedFile vertexSpirv;
+    MappedFile fragmentSpirv;
+    // 本次编译是否使用了 SPIR-V，映射在提交后就已关闭，finishLink 据此决定是否回退
+    bool usingSpirv = false;
+    uint64_t cacheKey = 0;
+    unsigned int vertexShader = 0;
+    unsigned int fragShader = 0;
+    // 热重载
+    bool hotReload = false;
+    uint64_t vertexHash = 0;
+    uint64_t fragmentHash = 0;
+    unsigned int preprocessorRevision = 0;
+    std::unique_ptr<Shader> reloading;
+    // ShaderTelemetry 中的记录，热重载替换 program 后换成新 program 的记录
+    unsigned int telemetryId = 0;
+    double requestTime = 0.0;
+    bool usedOnce = false;
+
+    // 只读取源码，编译和 link 由 ShaderBatch 统一提交
+    struct Deferred {};
+    Shader(const char* vertexPath, const char* fragmentPath, const std::string& defines,
+        const std::vector<SpecializationConstant>& constants, Deferred);
+
+    void readSource(const char* vertexPath, const char* fragmentPath);
+    void compile();
+    void link();
+    void finishLink();
+    void onLinked();
+    void watchSources();
+    void swapProgram(Shader& next);
     unsigned int createVertexShader(const std::string& vShaderCodes);
     unsigned int createFragShader(const std::string& fShaderCode);
+    unsigned int createSpirvShader(GLenum type, const MappedFile& spirv);
+    // SPIR-V 被驱动拒绝或缺少反射所需的名字时，改用 GLSL 源码重新编译
+    void fallbackToGLSL();
     unsigned int createShaderProgram(unsigned int vertexShader, unsigned int fragShader);
+    // 完整的 info log 写入 log，失败时同时输出到 std::cout
+    bool checkCompileStatus(unsigned int shader, const char* stage, std::string& log);
+    bool checkLinkStatus(unsigned int program, std::string& log);
 };
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "Shader.h"
+
+// 批量异步编译 shader：先一次性提交所有 shader 的编译，再统一提交 link，
+// 过程中不查询任何状态，驱动（开启 KHR_parallel_shader_compile 时）可以多线程并行编译
+// 渲染循环中用 Shader::isReady 判断是否可用，未就绪时先用 fallback program 绘制
+class ShaderBatch
+{
+public:
+    ShaderBatch();
+
+    // 只读取源码，返回的 Shader 由 batch 持有
+    Shader* add(const char* vertexPath, const char* fragmentPath, const std::string& defines = "",
+        const std::vector<SpecializationConstant>& constants = {});
+    // 提交尚未提交的 shader
+    void submit();
+    // 非阻塞地收集已完成的 program，返回仍在编译中的数量
+    size_t poll();
+    void release();
+private:
+    std::vector<std::unique_ptr<Shader>> shaders;
+    size_t submitted = 0;
+};
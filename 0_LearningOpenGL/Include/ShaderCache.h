@@ -0,0 +1,42 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <string>
+
+// program 二进制的磁盘缓存（glGetProgramBinary / glProgramBinary）
+// key 由 shader 源码、宏定义以及驱动信息（vendor/renderer/version）共同哈希得到，
+// 源码或驱动变化后 key 自然变化，旧文件不会再被命中；
+// 驱动拒绝加载的二进制会被删除，并由调用方回退到源码编译
+class ShaderCache
+{
+public:
+    static ShaderCache& instance();
+
+    void setDirectory(const std::string& directory);
+    bool isEnabled() const;
+
+    uint64_t makeKey(const std::string& vertexCode, const std::string& fragmentCode, const std::string& defines);
+    // 命中时返回已经 link 成功的 program，否则返回 0
+    // separable 的 program 需要在加载二进制之前设置 GL_PROGRAM_SEPARABLE
+    unsigned int load(uint64_t key, bool separable = false);
+    // program 需要在 link 之前设置 GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+    void store(uint64_t key, unsigned int program);
+
+    unsigned int getHits() const { return hits; }
+    unsigned int getMisses() const { return misses; }
+    unsigned int getRejected() const { return rejected; }
+    void printStats() const;
+private:
+    ShaderCache() = default;
+
+    std::string directory = "ShaderCache";
+    std::string driverInfo;
+    bool directoryCreated = false;
+    unsigned int hits = 0;
+    unsigned int misses = 0;
+    unsigned int rejected = 0;
+    unsigned int stores = 0;
+
+    std::string getPath(uint64_t key) const;
+};
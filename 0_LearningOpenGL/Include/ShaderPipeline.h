@@ -0,0 +1,100 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Shader.h"
+#include "ShaderBatch.h"
+#include "ShaderStage.h"
+#include "StringHash.h"
+
+// 由一个顶点阶段和一个片段阶段组成的 program pipeline
+// 支持 ARB_separate_shader_objects 时两个阶段各自独立编译，pipeline 对象只记录组合关系；
+// 否则退回到普通的 Shader，两个阶段 link 成一个 program
+class ShaderPipeline
+{
+    friend class ShaderPipelineCache;
+public:
+    // 两个阶段都 link 完成后才可用，不会阻塞
+    bool isReady();
+    bool isFailed() const;
+    // 会阻塞到两个阶段都 link 完成
+    void use();
+
+    // uniform 写入声明了它的阶段，separable 时用 glProgramUniform*，不需要先 use
+    void setBool(HashedString name, bool value) const;
+    void setInt(HashedString name, int value) const;
+    void setFloat(HashedString name, float value) const;
+
+    // 用于 uniform block 反射等需要 program 的地方，回退路径下两个阶段是同一个 program
+    unsigned int getProgram(GLenum type) const;
+    const std::vector<ShaderAttribute>& getAttributes() const;
+    uint64_t getAttributeSignature() const;
+private:
+    ShaderStage* vertex = nullptr;
+    ShaderStage* fragment = nullptr;
+    unsigned int pipeline = 0;
+    // 回退路径，由 ShaderPipelineCache 的 batch 持有
+    Shader* shader = nullptr;
+
+    void createPipeline();
+};
+
+// 阶段和 pipeline 的缓存：每个 (阶段, 文件, 宏定义) 只编译一次，
+// N 个顶点变体和 M 个片段变体最多编译 N + M 次，而不是 link N × M 个 program
+class ShaderPipelineCache
+{
+public:
+    static ShaderPipelineCache& instance();
+
+    ShaderStage& getStage(GLenum type, const char* path, const std::string& defines = "");
+    ShaderPipeline& get(const char* vertexPath, const char* fragmentPath,
+        const std::string& vertexDefines = "", const std::string& fragmentDefines = "");
+    // 每帧调用，收尾已完成的异步编译；没有 KHR_parallel_shader_compile 时每帧阻塞收尾一个阶段或 program
+    void update();
+    void release();
+    void printStats() const;
+private:
+    // 按值比较的 key，哈希只用于分桶
+    struct StageKey
+    {
+        GLenum type;
+        std::string path;
+        std::string defines;
+
+        bool operator==(const StageKey& other) const
+        {
+            return type == other.type && path == other.path && defines == other.defines;
+        }
+    };
+    struct PipelineKey
+    {
+        std::string vertexPath;
+        std::string vertexDefines;
+        std::string fragmentPath;
+        std::string fragmentDefines;
+
+        bool operator==(const PipelineKey& other) const
+        {
+            return vertexPath == other.vertexPath && vertexDefines == other.vertexDefines
+                && fragmentPath == other.fragmentPath && fragmentDefines == other.fragmentDefines;
+        }
+    };
+    struct KeyHash
+    {
+        size_t operator()(const StageKey& key) const;
+        size_t operator()(const PipelineKey& key) const;
+    };
+
+    std::unordered_map<StageKey, std::unique_ptr<ShaderStage>, KeyHash> stages;
+    std::unordered_map<PipelineKey, std::unique_ptr<ShaderPipeline>, KeyHash> pipelines;
+    std::unique_ptr<ShaderBatch> batch;
+
+    ShaderPipelineCache() = default;
+    static uint64_t hashParts(const std::string* parts, int count, uint64_t seed);
+    // 回退路径下两个阶段只有一份宏定义：按宏名合并，相同的定义只保留一次，同名但值不同时报错
+    static std::string mergeDefines(const std::string& vertexDefines, const std::string& fragmentDefines);
+};
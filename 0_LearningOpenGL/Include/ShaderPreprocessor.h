@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// GLSL 预处理：展开 #include "file"（路径相对于当前文件），支持 #pragma once
+// 记录所有 shader 文件之间的依赖图，文件修改后只让 include 闭包包含它的 translation unit 失效，
+// 其余 unit 直接使用缓存，不重新读取也不重新展开
+class ShaderPreprocessor
+{
+public:
+    // 展开后的一个完整 shader 源码
+    struct Unit
+    {
+        std::string source;
+        uint64_t hash = 0;
+        // include 闭包，第一个是根文件，下标即 #line 中的 source string number
+        std::vector<std::string> files;
+    };
+
+    static ShaderPreprocessor& instance();
+
+    const Unit& preprocess(const std::string& path);
+    // 根据 FileWatcher 的版本号重新读取修改过的文件，并使依赖它们的 unit 失效
+    void refresh();
+    // 每当有 unit 失效时加一，调用方可以据此跳过检查
+    unsigned int getRevision() const { return revision; }
+    // 在 #version 之后插入宏定义，并用 #line 恢复原来的行号
+    static std::string injectDefines(const std::string& source, const std::string& defines);
+    // 与 Python 的 os.path.normpath 相同，去掉 "." 和可以抵消的 ".."，分隔符统一为 '/'
+    // include 路径规范化之后，同一个文件只有一个 key，#pragma once、依赖图和文件监视才能对应上
+    static std::string normalizePath(const std::string& path);
+    // Tools/OptimizeShaders.py 的输出：同目录下的 Optimized/<文件名>
+    static std::string getOptimizedPath(const std::string& path);
+    // 读取优化后的源码，文件中记录的哈希与 unit 不一致（源码修改过）或文件不存在时返回 false
+    // 离线优化时没有任何宏，结果只适用于不带 defines 的变体，由调用者判断
+    static bool readOptimized(const Unit& unit, std::string& source);
+private:
+    struct SourceFile
+    {
+        std::string content;
+        uint64_t hash = 0;
+        unsigned int version = 0;
+        bool pragmaOnce = false;
+        // 依赖图的正向边和反向边
+        std::vector<std::string> includes;
+        std::unordered_set<std::string> includedBy;
+    };
+
+    std::unordered_map<std::string, SourceFile> files;
+    std::unordered_map<std::string, Unit> units;
+    unsigned int revision = 0;
+    unsigned int watcherGeneration = 0;
+
+    ShaderPreprocessor() = default;
+    SourceFile& getFile(const std::string& path);
+    // 带有 EMBEDDED_PATH_PREFIX 的路径从嵌入的数据中读取
+    void readFile(const std::string& path, SourceFile& file);
+    void updateIncludes(const std::string& path, SourceFile& file);
+    void expand(const std::string& path, Unit& unit, std::vector<std::string>& stack, std::unordered_set<std::string>& onceFiles);
+    void invalidateDependents(const std::string& path);
+    static bool parseInclude(const std::string& line, const std::string& from, std::string& includePath);
+    // 只匹配指令本身，行内注释中的文字不算
+    static bool isPragmaOnce(const std::string& line);
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Shader.h"
+#include "StringHash.h"
+#include "UniformTable.h"
+
+// 单独编译、单独 link 的一个 shader 阶段（ARB_separate_shader_objects 的 separable program）
+// 同一个阶段可以和任意其他阶段组合成 program pipeline，组合时不需要重新 link
+// 与 Shader 一样只提交编译和 link，状态在 isReady 或第一次使用时才查询
+class ShaderStage
+{
+    friend class ShaderPipelineCache;
+public:
+    // type 为 GL_VERTEX_SHADER 或 GL_FRAGMENT_SHADER
+    ShaderStage(GLenum type, const char* path, const std::string& defines = "");
+    void release();
+    bool isReady();
+    bool isFailed() const { return state == State::Failed; }
+    // 阻塞到 link 完成
+    void finishLink();
+
+    GLenum getType() const { return type; }
+    GLbitfield getStageBit() const;
+    unsigned int getProgram() const { return program; }
+    const std::string& getPath() const { return path; }
+    int getUniformLocation(HashedString name) const;
+    // 只有顶点阶段有顶点输入
+    const std::vector<ShaderAttribute>& getAttributes() const { return attributes; }
+    uint64_t getAttributeSignature() const { return attributeSignature; }
+private:
+    enum class State { Linking, Ready, Failed };
+
+    GLenum type;
+    std::string path;
+    unsigned int program = 0;
+    unsigned int shader = 0;
+    uint64_t cacheKey = 0;
+    State state = State::Linking;
+    UniformTable uniforms;
+    std::vector<ShaderAttribute> attributes;
+    uint64_t attributeSignature = 0;
+    // ShaderTelemetry 中的记录，只使用与 type 对应的那个阶段的字段
+    unsigned int telemetryId = 0;
+    double requestTime = 0.0;
+
+    void onLinked();
+    static std::string buildPrologue(GLenum type, const std::string& defines);
+};
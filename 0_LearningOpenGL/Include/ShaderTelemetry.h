@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// 一次 program 构建（包括热重载产生的新 program）的耗时与日志，时间单位为毫秒
+// 异步编译时 compile/link 只包含提交耗时和查询状态时阻塞的时间，驱动在后台花费的时间体现在 readyMs 中
+struct ShaderProgramStats
+{
+    // 顶点和片段 shader 路径，separable 的单个阶段只有一个路径
+    std::string name;
+    std::string defines;
+    bool cacheHit = false;
+    bool spirv = false;
+    // SPIR-V 被拒绝后改用 GLSL 重新编译
+    bool spirvFallback = false;
+    bool linked = false;
+    double readMs = 0.0;
+    double vertexCompileMs = 0.0;
+    double fragmentCompileMs = 0.0;
+    // 命中缓存时为 glProgramBinary 的耗时
+    double linkMs = 0.0;
+    // 从开始读取源码到 program 可用所经过的时间
+    double readyMs = 0.0;
+    // 第一次 use 时阻塞的时间，小于 0 表示还没有被使用
+    double firstUseMs = -1.0;
+    // 完整的 info log（不截断），没有内容时为空
+    std::string vertexLog;
+    std::string fragmentLog;
+    std::string linkLog;
+
+    double getTotalMs() const { return readMs + vertexCompileMs + fragmentCompileMs + linkMs; }
+};
+
+// 收集所有 shader 的编译统计，可以通过接口查询，也可以在退出时写成 JSON 用于跨版本对比
+// 记录用编号访问，vector 扩容后之前取得的引用会失效
+class ShaderTelemetry
+{
+public:
+    static ShaderTelemetry& instance();
+    // 单调时钟，毫秒
+    static double now();
+
+    unsigned int begin(const std::string& name, const std::string& defines);
+    ShaderProgramStats& get(unsigned int id) { return records[id]; }
+    const std::vector<ShaderProgramStats>& getRecords() const { return records; }
+    // 按 getTotalMs 从大到小返回最慢的 count 个
+    std::vector<const ShaderProgramStats*> getSlowest(size_t count) const;
+
+    void printSummary(size_t count = 5) const;
+    // 失败时输出 ERROR::SHADER::TELEMETRY::WRITE_FAILED 并返回 false
+    bool writeJson(const std::string& path) const;
+private:
+    ShaderTelemetry() = default;
+
+    std::vector<ShaderProgramStats> records;
+};
+
+// 按 GL_INFO_LOG_LENGTH 分配，返回完整的 info log
+std::string getShaderInfoLog(unsigned int shader);
+std::string getProgramInfoLog(unsigned int program);
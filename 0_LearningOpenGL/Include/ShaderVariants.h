@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "Shader.h"
+#include "ShaderBatch.h"
+
+// 同一组 shader 源码的多个变体（permutation），以 feature 宏的 bitmask 作为 key
+// 第 i 个 feature 对应 bit i，同时也是特化常量 constant_id = i，值为 0 或 1
+// GLSL 路径下插入 "#define FEATURE 0/1"，shader 中用 if (FEATURE != 0) 判断，不能再用 #ifdef；
+// SPIR-V 路径下所有变体共用同一个模块，只是特化常量不同
+// 变体在第一次请求时才提交编译，源码中没有用到的 feature 会被去掉，得到相同源码的 mask 共享同一个 program
+// 编译结果经过 Shader 写入 program 二进制缓存，上次运行用到的变体可以在启动时异步预热
+class ShaderVariants
+{
+public:
+    ShaderVariants(const char* vertexPath, const char* fragmentPath, const std::vector<std::string>& features);
+
+    // 返回的 Shader 可能还在编译，可用 isReady 判断，或者直接 use（会阻塞到编译完成）
+    Shader& get(uint32_t mask);
+    // 读取上次运行记录的 mask 列表，全部提交异步编译
+    void prewarm(const std::string& usageLogPath);
+    // 记录本次运行请求过的 mask，供下次 prewarm 使用
+    void saveUsageLog(const std::string& usageLogPath) const;
+    // 每帧调用，收尾已完成的异步编译并处理热重载
+    void update();
+    void enableHotReload();
+    void release();
+private:
+    std::string vertexPath;
+    std::string fragmentPath;
+    std::vector<std::string> features;
+    // 源码中实际出现的 feature 对应的位
+    uint32_t usedMask = 0;
+    bool hotReload = false;
+    ShaderBatch batch;
+    std::unordered_map<uint32_t, Shader*> variants;
+    std::unordered_set<uint32_t> requested;
+
+    // 只加入 batch，由调用方统一 submit
+    Shader* create(uint32_t mask);
+    std::vector<SpecializationConstant> buildConstants(uint32_t mask) const;
+};
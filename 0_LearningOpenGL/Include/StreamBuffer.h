@@ -0,0 +1,67 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <vector>
+
+// 一段已分配的流式数据，offset 相对于整个 buffer，data 直接指向映射的显存，写完即可使用
+struct StreamBufferRange
+{
+    unsigned int offset;
+    unsigned int size;
+    void* data;
+};
+
+// 每帧更新的顶点、索引和 uniform 数据共用的环形缓冲，分成 frameCount 个帧区域，每个区域用 fence 保护：
+// - GL 4.4 / ARB_buffer_storage：用 GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT 创建并只映射一次，
+//   之后直接写入映射的内存，不再有 glBufferData 重新分配（orphan）或 glBufferSubData 的拷贝
+// - GL 3.3：每帧用 GL_MAP_UNSYNCHRONIZED_BIT 映射本帧区域，同步由 fence 负责，驱动不会等待 GPU；
+//   映射中的 buffer 不能被绘制使用，绘制前需要 flush 解除映射
+// buffer 对象不区分类型，同一个 buffer 可以同时绑定为 GL_ARRAY_BUFFER、GL_ELEMENT_ARRAY_BUFFER 和 GL_UNIFORM_BUFFER
+class StreamBuffer
+{
+public:
+    StreamBuffer(unsigned int frameCapacity, unsigned int frameCount = 3);
+
+    // 等待 GPU 用完 frameCount 帧之前写入的本帧区域
+    void beginFrame();
+    // 返回的 offset（相对于整个 buffer）按 alignment 对齐，空间不足时返回 data 为 nullptr 的区间
+    // size 为 0 时返回大小为 0 的空区间，不算错误
+    StreamBufferRange allocate(unsigned int size, unsigned int alignment);
+    // 顶点按 stride 对齐，可以用 offset / stride 作为 baseVertex
+    StreamBufferRange allocateVertices(unsigned int size, unsigned int stride) { return allocate(size, stride); }
+    // 索引按索引大小对齐，绘制时的偏移为 offset
+    StreamBufferRange allocateIndices(unsigned int size, unsigned int indexSize) { return allocate(size, indexSize); }
+    // 按 GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 对齐，可以直接 glBindBufferRange
+    StreamBufferRange allocateUniforms(unsigned int size) { return allocate(size, uniformAlignment); }
+    // 让本帧写入的数据对之后的绘制可见，必须在使用这些数据的绘制之前调用
+    void flush();
+    void endFrame();
+    void release();
+
+    unsigned int getBuffer() const { return buffer; }
+    bool isPersistent() const { return persistent; }
+    unsigned int getUploadedBytes() const { return uploadedBytes; }
+    void printStats() const;
+private:
+    unsigned int buffer = 0;
+    unsigned int frameCapacity;
+    unsigned int frameCount;
+    unsigned int frameIndex = 0;
+    unsigned int uniformAlignment = 256;
+    bool persistent = false;
+    // 持久映射时为整个 buffer 的起点；GL 3.3 时为当前映射区间的起点，没有映射时为 nullptr
+    char* mapped = nullptr;
+    unsigned int mappedOffset = 0;
+    unsigned int cursor = 0;
+    unsigned int flushed = 0;
+    std::vector<GLsync> fences;
+
+    unsigned int uploadedBytes = 0;
+    unsigned int frames = 0;
+    // 需要真正等待 GPU 的次数和等待时间
+    unsigned int stalls = 0;
+    double waitMs = 0.0;
+    double maxWaitMs = 0.0;
+
+    bool map();
+};
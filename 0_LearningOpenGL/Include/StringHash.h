@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+// FNV-1a 32 位哈希，constexpr 版本可以在编译期对字符串字面量求值
+constexpr uint32_t hashString(const char* str, size_t length)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; ++i)
+    {
+        hash ^= static_cast<uint8_t>(str[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+constexpr uint32_t hashString(const char* str)
+{
+    uint32_t hash = 2166136261u;
+    for (; *str != '\0'; ++str)
+    {
+        hash ^= static_cast<uint8_t>(*str);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// FNV-1a 64 位哈希，用于文件内容等较长的数据，seed 可以串联多段数据
+inline uint64_t hashBytes64(const void* data, size_t length, uint64_t seed = 14695981039346656037ull)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = seed;
+    for (size_t i = 0; i < length; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+constexpr size_t stringLength(const char* str)
+{
+    size_t length = 0;
+    while (str[length] != '\0')
+    {
+        ++length;
+    }
+    return length;
+}
+
+// 预先算好哈希的名字，字面量会在编译期完成哈希，std::string 则在运行时哈希
+// 同时保留名字本身，查表时哈希相同还要比较名字；只作为参数临时使用，不能比传入的字符串活得更久
+struct HashedString
+{
+    uint32_t hash;
+    const char* name;
+    size_t length;
+
+    constexpr HashedString(const char* name) : hash(hashString(name)), name(name), length(stringLength(name)) {}
+    HashedString(const std::string& name) : hash(hashString(name.c_str(), name.size())), name(name.c_str()), length(name.size()) {}
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <string>
+#include "MathTypes.h"
+#include "Shader.h"
+#include "StringHash.h"
+
+// 各类型对应的 glUniform* 调用
+template <typename T>
+struct UniformTraits;
+
+template <>
+struct UniformTraits<float>
+{
+    static void upload(int location, int count, const float* values) { glUniform1fv(location, count, values); }
+};
+
+template <>
+struct UniformTraits<int>
+{
+    static void upload(int location, int count, const int* values) { glUniform1iv(location, count, values); }
+};
+
+template <>
+struct UniformTraits<unsigned int>
+{
+    static void upload(int location, int count, const unsigned int* values) { glUniform1uiv(location, count, values); }
+};
+
+template <>
+struct UniformTraits<Vec2>
+{
+    static void upload(int location, int count, const Vec2* values) { glUniform2fv(location, count, &values->x); }
+};
+
+template <>
+struct UniformTraits<Vec3>
+{
+    static void upload(int location, int count, const Vec3* values) { glUniform3fv(location, count, &values->x); }
+};
+
+template <>
+struct UniformTraits<Vec4>
+{
+    static void upload(int location, int count, const Vec4* values) { glUniform4fv(location, count, &values->x); }
+};
+
+template <>
+struct UniformTraits<Mat3>
+{
+    static void upload(int location, int count, const Mat3* values) { glUniformMatrix3fv(location, count, GL_FALSE, values->m); }
+};
+
+template <>
+struct UniformTraits<Mat4>
+{
+    static void upload(int location, int count, const Mat4* values) { glUniformMatrix4fv(location, count, GL_FALSE, values->m); }
+};
+
+// 类型化的 uniform 句柄，名字在编译期哈希：
+//     static Uniform<float> ratio("ratio");
+//     ratio.set(shader, value);
+// location 只在 program 第一次使用或重新 link（热重载）后解析一次，之后 set 就是一次普通的 glUniform* 调用
+// 与 glUniform* 一样，set 之前 shader 必须是当前 program
+// HashedString 只保存名字的指针，句柄通常是 static 的，只接受字符串字面量，不接受会先于它销毁的 std::string
+template <typename T>
+class Uniform
+{
+public:
+    template <size_t N>
+    constexpr explicit Uniform(const char (&name)[N]) : name(name) {}
+    Uniform(const std::string& name) = delete;
+
+    int resolve(const Shader& shader)
+    {
+        if (shader.getLinkStamp() != linkStamp)
+        {
+            location = shader.getUniformLocation(name);
+            linkStamp = shader.getLinkStamp();
+        }
+        return location;
+    }
+
+    void set(const Shader& shader, const T& value)
+    {
+        UniformTraits<T>::upload(resolve(shader), 1, &value);
+    }
+
+    // uniform 数组，从第 0 个元素开始设置 count 个
+    void setArray(const Shader& shader, const T* values, int count)
+    {
+        UniformTraits<T>::upload(resolve(shader), count, values);
+    }
+private:
+    HashedString name;
+    int location = -1;
+    unsigned int linkStamp = 0;
+};
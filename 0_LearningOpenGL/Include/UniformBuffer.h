@@ -0,0 +1,124 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "MathTypes.h"
+#include "StreamBuffer.h"
+#include "StringHash.h"
+
+// 约定的 uniform block 绑定点，program link 后按名字自动绑定
+enum class UniformBlockSlot : unsigned int
+{
+    PerFrame = 0,
+    PerMaterial = 1,
+    PerObject = 2,
+    Count
+};
+
+const char* getUniformBlockName(UniformBlockSlot slot);
+// 把 program 中名字匹配的 uniform block 绑定到约定的绑定点
+void bindUniformBlockSlots(unsigned int program);
+
+// 通过 program 反射得到的 std140 uniform block 布局
+// std140 的布局与驱动无关，同样声明的 block 在不同 program 中布局相同，反射一次即可复用
+class UniformBlockLayout
+{
+public:
+    bool reflect(unsigned int program, const char* blockName);
+    bool isValid() const { return size > 0; }
+    unsigned int getSize() const { return size; }
+
+    // block 指向 UniformBufferRing::allocate 返回的内存
+    template <typename T>
+    void set(void* block, HashedString name, const T& value) const
+    {
+        setArray(block, name, &value, 1);
+    }
+
+    template <typename T>
+    void setArray(void* block, HashedString name, const T* values, int count) const
+    {
+        const Member* member = find(name);
+        if (member == nullptr || block == nullptr)
+        {
+            return;
+        }
+        char* dst = static_cast<char*>(block) + member->offset;
+        for (int i = 0; i < count; ++i)
+        {
+            write(dst + i * member->arrayStride, *member, values[i]);
+        }
+    }
+private:
+    struct Member
+    {
+        uint32_t hash;
+        int offset;
+        int arrayStride;
+        int matrixStride;
+        // 名字在 names 中的位置，哈希相同时比较名字
+        uint32_t nameOffset;
+        uint32_t nameLength;
+    };
+    // 按哈希排序，二分查找
+    std::vector<Member> members;
+    std::vector<char> names;
+    unsigned int size = 0;
+
+    const Member* find(HashedString name) const;
+
+    template <typename T>
+    static void write(char* dst, const Member&, const T& value)
+    {
+        memcpy(dst, &value, sizeof(T));
+    }
+    // std140 中矩阵的每一列按 vec4 对齐
+    static void write(char* dst, const Member& member, const Mat3& value)
+    {
+        for (int column = 0; column < 3; ++column)
+        {
+            memcpy(dst + column * member.matrixStride, value.m + column * 3, sizeof(float) * 3);
+        }
+    }
+    static void write(char* dst, const Member& member, const Mat4& value)
+    {
+        for (int column = 0; column < 4; ++column)
+        {
+            memcpy(dst + column * member.matrixStride, value.m + column * 4, sizeof(float) * 4);
+        }
+    }
+};
+
+// 一段已分配的 uniform 数据，offset 相对于整个 UBO
+struct UniformBufferRange
+{
+    unsigned int offset;
+    unsigned int size;
+    void* data;
+};
+
+// 按帧划分的 UBO 环形缓冲：
+// 每帧的 per-frame/per-material/per-object 数据直接写入 StreamBuffer 映射的内存，
+// 绘制时用 glBindBufferRange 绑定对应区间，不再为每个 uniform 单独调用 glUniform*
+// 每帧区域用 fence 保护，GPU 还在读取的区域不会被覆盖
+class UniformBufferRing
+{
+public:
+    UniformBufferRing(unsigned int frameCapacity, unsigned int frameCount = 3);
+
+    void beginFrame();
+    // 返回的内存按 GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 对齐
+    UniformBufferRange allocate(unsigned int size);
+    // 让本帧写入的数据对之后的绘制可见，必须在使用这些数据的绘制之前调用
+    void flush();
+    void bind(UniformBlockSlot slot, const UniformBufferRange& range);
+    void endFrame();
+    void release();
+
+    unsigned int getUploadedBytes() const { return stream.getUploadedBytes(); }
+    void printStats() const { stream.printStats(); }
+private:
+    StreamBuffer stream;
+};
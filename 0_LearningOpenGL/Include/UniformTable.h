@@ -0,0 +1,37 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <vector>
+#include "StringHash.h"
+
+// program link 成功后，用 glGetActiveUniform 枚举所有 active uniform，
+// 建立 名字哈希 -> location 的扁平哈希表（开放寻址）
+// 查询时只做一次取模和少量探测，不分配内存，也不调用 glGetUniformLocation；
+// 哈希相同时再比较名字，不存在的名字不会因为哈希冲突得到别的 uniform 的 location
+class UniformTable
+{
+public:
+    void build(unsigned int program);
+    void clear();
+    // 找不到时返回 -1，glUniform* 会静默忽略 -1
+    int find(HashedString name) const;
+    size_t size() const { return count; }
+private:
+    struct Slot
+    {
+        uint32_t hash;
+        int location; // -1 表示空槽
+        // 名字在 names 中的位置
+        uint32_t nameOffset;
+        uint32_t nameLength;
+    };
+    std::vector<Slot> slots;
+    // 所有名字连续存放，不为每个槽单独分配
+    std::vector<char> names;
+    uint32_t mask = 0;
+    size_t count = 0;
+
+    bool matches(const Slot& slot, const char* name, size_t length) const;
+    void insert(uint32_t hash, int location, const std::string& name);
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Shader.h"
+#include "ShaderPipeline.h"
+#include "VertexLayout.h"
+
+// 按 (顶点格式, shader 顶点输入) 缓存 VAO
+// 第一次遇到某个组合时用 shader 反射出的 location 配置属性，并检查格式与 shader 是否匹配；
+// 之后共用同一格式的 mesh 只需要切换顶点/索引缓冲：
+// 支持 ARB_vertex_attrib_binding 时用 glBindVertexBuffer，否则只在缓冲变化时重新设置属性指针
+// 实例化绘制时另有一个实例缓冲：instanceLayout 中的属性 divisor 为 1，每个实例前进一次
+class VertexArrayCache
+{
+public:
+    static VertexArrayCache& instance();
+
+    void bind(const VertexLayout& layout, const Shader& shader, unsigned int vertexBuffer, unsigned int indexBuffer);
+    // 顶点输入来自 pipeline 的顶点阶段
+    void bind(const VertexLayout& layout, const ShaderPipeline& pipeline, unsigned int vertexBuffer, unsigned int indexBuffer);
+    // 实例数据从 instanceBuffer 的 instanceOffset 字节处开始；GL 3.3 没有 baseInstance，每批实例用偏移区分
+    void bind(const VertexLayout& layout, const VertexLayout& instanceLayout, const Shader& shader,
+        unsigned int vertexBuffer, unsigned int instanceBuffer, unsigned int instanceOffset, unsigned int indexBuffer);
+    // 缓冲删除后名字可能被新建的缓冲复用，由 GLState::deleteBuffer 调用；
+    // 引用它的 VAO 记录的缓冲改为未知，下次 bind 时一定重新设置，不会因为名字相同而跳过
+    void invalidateBuffer(unsigned int buffer);
+    void release();
+private:
+    // 同一个 layout 常量的地址不变，与 shader 的输入一起作为 key；哈希只用于分桶，相等由 operator== 判断
+    struct Key
+    {
+        const VertexAttribute* attributes;
+        const VertexAttribute* instanceAttributes;
+        uint64_t signature;
+        // 查找时指向 shader 的输入，存入表中的 key 指向 Entry 持有的拷贝
+        const std::vector<ShaderAttribute>* inputs;
+
+        bool operator==(const Key& other) const;
+    };
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry
+    {
+        unsigned int vertexArray;
+        unsigned int vertexBuffer;
+        unsigned int indexBuffer;
+        unsigned int instanceBuffer;
+        unsigned int instanceOffset;
+        // shader 中用到的属性：layout 中的下标与 location
+        std::vector<std::pair<int, int>> bindings;
+        std::vector<std::pair<int, int>> instanceBindings;
+        // key 中 inputs 指向的拷贝，Entry 移动时地址不变
+        std::unique_ptr<std::vector<ShaderAttribute>> inputs;
+    };
+    std::unordered_map<Key, Entry, KeyHash> entries;
+
+    VertexArrayCache() = default;
+    Entry& find(const VertexLayout& layout, const VertexLayout* instanceLayout, const std::vector<ShaderAttribute>& inputs, uint64_t signature);
+    void bind(const VertexLayout& layout, const std::vector<ShaderAttribute>& inputs, uint64_t signature,
+        unsigned int vertexBuffer, unsigned int indexBuffer);
+    void bindBuffers(const VertexLayout& layout, Entry& entry, unsigned int vertexBuffer, unsigned int indexBuffer);
+    Entry create(const VertexLayout& layout, const VertexLayout* instanceLayout, const std::vector<ShaderAttribute>& inputs);
+    static void setAttributePointers(const VertexLayout& layout, const std::vector<std::pair<int, int>>& bindings,
+        unsigned int buffer, unsigned int offset);
+};
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <GLFW/glfw3.h>
+#include "ShaderPipeline.h"
+
+// 对比 float 顶点格式与量化格式（half / 16 位定点）的显存占用和帧时间
+// 用一个细分很密的网格反复绘制，使顶点拉取成为瓶颈；GPU 时间用 GL_TIME_ELAPSED 查询
+// floatPipeline 的顶点阶段为 MeshShader.vert，quantizedPipeline 的顶点阶段为 QuantizedMeshShader.vert
+void runVertexBenchmark(GLFWwindow* window, ShaderPipeline& floatPipeline, ShaderPipeline& quantizedPipeline);
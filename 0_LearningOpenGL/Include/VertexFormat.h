@@ -0,0 +1,166 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <utility>
+#include "VertexLayout.h"
+
+// 编译期生成的顶点格式：
+//     using PositionColorFormat = VertexFormat<Position3f, Color4ub>;
+//     PositionColorFormat::stride / PositionColorFormat::offset<1>() / PositionColorFormat::layout
+// stride、offset 和 GL 类型都在编译期计算，layout 可以直接交给 VertexArrayCache::bind
+// 属性之间紧密排列，不允许出现需要填充的格式：每个属性都必须是 4 字节的整数倍（否则之后的属性不再 4 字节对齐，
+// 部分硬件会退化到慢速路径），名字不能重复；与 CPU 端的顶点结构体比较大小可以发现编译器插入的填充
+
+// 属性的存储格式：分量类型、分量数量、是否归一化（整数映射到 [0, 1] 或 [-1, 1]）
+template <GLenum Type, int Components, bool Normalized = false>
+struct VertexElement
+{
+    static constexpr GLenum type = Type;
+    static constexpr int components = Components;
+    static constexpr bool normalized = Normalized;
+
+    static constexpr bool isPacked()
+    {
+        return Type == GL_INT_2_10_10_10_REV || Type == GL_UNSIGNED_INT_2_10_10_10_REV;
+    }
+    static constexpr unsigned int getComponentSize()
+    {
+        return Type == GL_BYTE || Type == GL_UNSIGNED_BYTE ? 1
+            : Type == GL_SHORT || Type == GL_UNSIGNED_SHORT || Type == GL_HALF_FLOAT ? 2
+            : Type == GL_DOUBLE ? 8 : 4;
+    }
+    // 打包格式 4 个分量共用一个 32 位整数
+    static constexpr unsigned int size = isPacked() ? 4 : getComponentSize() * Components;
+
+    static_assert(Components >= 1 && Components <= 4, "vertex element must have 1 to 4 components");
+    static_assert(!isPacked() || Components == 4, "packed 2_10_10_10 elements must have 4 components");
+    static_assert(!Normalized || (Type != GL_FLOAT && Type != GL_HALF_FLOAT && Type != GL_DOUBLE),
+        "only integer elements can be normalized");
+};
+
+// 常用属性，名字与 shader 中的顶点输入对应
+struct Position3f : VertexElement<GL_FLOAT, 3> { static constexpr const char* name() { return "aPos"; } };
+// 半精度位置，w 分量用于补齐到 8 字节
+struct Position4h : VertexElement<GL_HALF_FLOAT, 4> { static constexpr const char* name() { return "aPos"; } };
+// 16 位定点位置（包围盒内映射到 [0, 1]），需要配合包围盒在 shader 中还原
+// 用无符号格式：有符号归一化的换算规则在 GL 4.2 前后不同，无符号的在所有版本中都是 c / 65535
+struct Position4us : VertexElement<GL_UNSIGNED_SHORT, 4, true> { static constexpr const char* name() { return "aPos"; } };
+struct Normal3f : VertexElement<GL_FLOAT, 3> { static constexpr const char* name() { return "aNormal"; } };
+struct Normal4p : VertexElement<GL_INT_2_10_10_10_REV, 4, true> { static constexpr const char* name() { return "aNormal"; } };
+struct Color3f : VertexElement<GL_FLOAT, 3> { static constexpr const char* name() { return "aColor"; } };
+struct Color4ub : VertexElement<GL_UNSIGNED_BYTE, 4, true> { static constexpr const char* name() { return "aColor"; } };
+struct TexCoord2f : VertexElement<GL_FLOAT, 2> { static constexpr const char* name() { return "aTexCoord"; } };
+struct TexCoord2h : VertexElement<GL_HALF_FLOAT, 2> { static constexpr const char* name() { return "aTexCoord"; } };
+struct TexCoord2us : VertexElement<GL_UNSIGNED_SHORT, 2, true> { static constexpr const char* name() { return "aTexCoord"; } };
+
+// 实例属性，用于 InstanceBatcher 的实例格式
+// 2D 变换：xy 平移、缩放、旋转角（弧度）
+struct InstanceTransform4f : VertexElement<GL_FLOAT, 4> { static constexpr const char* name() { return "aInstanceTransform"; } };
+struct InstanceColor3f : VertexElement<GL_FLOAT, 3> { static constexpr const char* name() { return "aInstanceColor"; } };
+struct InstanceRatio1f : VertexElement<GL_FLOAT, 1> { static constexpr const char* name() { return "aInstanceRatio"; } };
+
+namespace VertexFormatDetail
+{
+    // 前 index 个属性的大小之和
+    template <class... Elements>
+    constexpr unsigned int getOffset(size_t index)
+    {
+        const unsigned int sizes[] = { 0u, Elements::size... };
+        unsigned int offset = 0;
+        for (size_t i = 0; i < index; ++i)
+        {
+            offset += sizes[i + 1];
+        }
+        return offset;
+    }
+
+    template <class... Elements>
+    constexpr bool isAligned()
+    {
+        const unsigned int sizes[] = { 4u, Elements::size... };
+        for (unsigned int size : sizes)
+        {
+            if (size % 4 != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    constexpr bool isSameName(const char* a, const char* b)
+    {
+        while (*a != '\0' && *a == *b)
+        {
+            ++a;
+            ++b;
+        }
+        return *a == *b;
+    }
+
+    template <class... Elements>
+    constexpr bool hasUniqueNames()
+    {
+        const char* names[] = { "", Elements::name()... };
+        const size_t count = sizeof(names) / sizeof(names[0]);
+        for (size_t i = 1; i < count; ++i)
+        {
+            for (size_t j = i + 1; j < count; ++j)
+            {
+                if (isSameName(names[i], names[j]))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    template <class Indices, class... Elements>
+    struct Attributes;
+
+    template <size_t... Indices, class... Elements>
+    struct Attributes<std::index_sequence<Indices...>, Elements...>
+    {
+        static constexpr VertexAttribute values[] = {
+            { Elements::name(), Elements::components, Elements::type, Elements::normalized, getOffset<Elements...>(Indices) }...
+        };
+    };
+
+    template <size_t... Indices, class... Elements>
+    constexpr VertexAttribute Attributes<std::index_sequence<Indices...>, Elements...>::values[];
+}
+
+template <class... Elements>
+struct VertexFormat
+{
+    static_assert(sizeof...(Elements) > 0, "vertex format needs at least one element");
+    static_assert(VertexFormatDetail::isAligned<Elements...>(),
+        "every vertex element must be a multiple of 4 bytes, pad 3-component byte/half elements to 4");
+    static_assert(VertexFormatDetail::hasUniqueNames<Elements...>(), "vertex element names must be unique");
+
+    static constexpr int count = (int)sizeof...(Elements);
+    static constexpr unsigned int stride = VertexFormatDetail::getOffset<Elements...>(sizeof...(Elements));
+    // 地址固定，VertexArrayCache 以它作为 key 的一部分
+    static constexpr const VertexAttribute* attributes =
+        VertexFormatDetail::Attributes<std::index_sequence_for<Elements...>, Elements...>::values;
+    static constexpr VertexLayout layout = { attributes, count, stride };
+
+    template <size_t Index>
+    static constexpr unsigned int offset()
+    {
+        static_assert(Index < sizeof...(Elements), "vertex element index out of range");
+        return VertexFormatDetail::getOffset<Elements...>(Index);
+    }
+
+    // CPU 端的顶点结构体与格式大小一致（没有编译器插入的填充），用于 static_assert
+    template <class Vertex>
+    static constexpr bool matches()
+    {
+        return sizeof(Vertex) == stride;
+    }
+};
+
+template <class... Elements>
+constexpr VertexLayout VertexFormat<Elements...>::layout;
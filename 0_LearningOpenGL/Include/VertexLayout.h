@@ -0,0 +1,24 @@
+#pragma once
+
+#include <glad/glad.h>
+
+// 顶点格式的描述，可以定义为 constexpr 常量：
+//     constexpr VertexAttribute kAttributes[] = { { "aPos", 3, GL_FLOAT, false, 0 }, ... };
+//     constexpr VertexLayout kLayout = { kAttributes, 2, 6 * sizeof(float) };
+// 属性按名字与 shader 的顶点输入对应，location 由 shader 反射得到，不再硬编码
+// 一般不需要手写，用 VertexFormat（VertexFormat.h）在编译期生成
+struct VertexAttribute
+{
+    const char* name;
+    int components;
+    GLenum type;
+    bool normalized;
+    unsigned int offset;
+};
+
+struct VertexLayout
+{
+    const VertexAttribute* attributes;
+    int count;
+    unsigned int stride;
+};
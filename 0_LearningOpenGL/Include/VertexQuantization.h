@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "MathTypes.h"
+#include "VertexFormat.h"
+
+// 量化之前的顶点，36 字节
+struct MeshVertex
+{
+    float position[3];
+    float normal[3];
+    float color[3];
+};
+using MeshVertexFormat = VertexFormat<Position3f, Normal3f, Color3f>;
+static_assert(MeshVertexFormat::matches<MeshVertex>(), "MeshVertex does not match MeshVertexFormat");
+
+// 量化之后的顶点，16 字节：位置 4 x 16 位，法线 10-10-10-2，颜色 4 x 8 位
+struct QuantizedVertex
+{
+    uint16_t position[4];
+    uint32_t normal;
+    uint8_t color[4];
+};
+using QuantizedHalfFormat = VertexFormat<Position4h, Normal4p, Color4ub>;
+using QuantizedFixedFormat = VertexFormat<Position4us, Normal4p, Color4ub>;
+static_assert(QuantizedHalfFormat::matches<QuantizedVertex>(), "QuantizedVertex does not match QuantizedHalfFormat");
+static_assert(QuantizedFixedFormat::matches<QuantizedVertex>(), "QuantizedVertex does not match QuantizedFixedFormat");
+
+enum class PositionEncoding
+{
+    // 半精度浮点，相对包围盒中心、按半边长缩放到 [-1, 1]
+    Half,
+    // 16 位无符号归一化，包围盒映射到 [0, 1]
+    Fixed16
+};
+
+// 每个 mesh 一份的反量化变换：position = aPos.xyz * scale + offset
+// 与 shader 中 PerObject block 的 positionScale/positionOffset 对应（std140 下 vec4 对齐）
+struct PositionTransform
+{
+    Vec4 scale;
+    Vec4 offset;
+};
+
+struct QuantizedMesh
+{
+    PositionEncoding encoding = PositionEncoding::Half;
+    std::vector<QuantizedVertex> vertices;
+    PositionTransform transform = {};
+    // 反量化后与原始位置的最大误差（各分量绝对值），用于确认精度是否足够
+    float maxPositionError = 0.0f;
+
+    const VertexLayout& getLayout() const;
+};
+
+QuantizedMesh quantizeMesh(const std::vector<MeshVertex>& vertices, PositionEncoding encoding);
+
+// IEEE 754 半精度，最近偶数舍入，超出范围时为无穷大
+uint16_t floatToHalf(float value);
+float halfToFloat(uint16_t value);
+// [0, 1] -> [0, 255]
+uint8_t packUnorm8(float value);
+// [0, 1] -> [0, 65535]
+uint16_t packUnorm16(float value);
+// 每个分量 [-1, 1]，x 在最低位；按 GL 4.2 之后的规则（c / 511）编码，
+// GL 3.3 的 (2c + 1) / 1023 规则下误差不超过 1 个最低位，法线在 shader 中归一化即可
+uint32_t packSnorm10_10_10_2(float x, float y, float z, float w);
@@ -0,0 +1,11 @@
+#version 330 core
+
+out vec4 fragColor;
+// 由 Uniform<Vec3> 每帧设置，随时间明暗变化，表示正式的 program 还在编译
+uniform vec3 fallbackColor;
+
+// 正式的 program 编译完成之前使用的纯色 shader
+void main()
+{
+	fragColor = vec4(fallbackColor, 1.0);
+}
\ No newline at end of file
@@ -2,7 +2,10 @@
 
 out vec4 fragColor;
 in vec3 ourColor;
-uniform float ratio;
+layout (std140) uniform PerFrame
+{
+	float ratio;
+};
 
 void main()
 {
@@ -0,0 +1,19 @@
+#version 330 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aColor;
+// 每个实例一份（glVertexAttribDivisor = 1）：xy 平移、缩放、旋转角（弧度）
+layout (location = 2) in vec4 aInstanceTransform;
+layout (location = 3) in vec3 aInstanceColor;
+layout (location = 4) in float aInstanceRatio;
+
+out vec3 ourColor;
+
+void main()
+{
+   float s = sin(aInstanceTransform.w);
+   float c = cos(aInstanceTransform.w);
+   vec2 position = mat2(c, s, -s, c) * aPos.xy * aInstanceTransform.z + aInstanceTransform.xy;
+   gl_Position = vec4(position, aPos.z, 1.0);
+   ourColor = aColor * aInstanceColor * aInstanceRatio;
+}
\ No newline at end of file
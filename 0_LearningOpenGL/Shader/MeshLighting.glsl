@@ -0,0 +1,8 @@
+#pragma once
+
+// 固定方向光的漫反射，量化和未量化的 mesh 共用，保证两者画出相同的结果
+vec3 shadeVertex(vec3 normal, vec3 color)
+{
+   vec3 lightDirection = normalize(vec3(0.3, 0.5, 1.0));
+   return color * (0.2 + 0.8 * max(dot(normalize(normal), lightDirection), 0.0));
+}
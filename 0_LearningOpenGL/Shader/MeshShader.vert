@@ -0,0 +1,15 @@
+#version 330 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec3 aColor;
+
+#include "MeshLighting.glsl"
+
+out vec3 ourColor;
+
+void main()
+{
+   gl_Position = vec4(aPos, 1.0);
+   ourColor = shadeVertex(aNormal, aColor);
+}
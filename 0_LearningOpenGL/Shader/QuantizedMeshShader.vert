@@ -0,0 +1,23 @@
+#version 330 core
+
+// 位置为 16 位（half 或归一化整数），法线为 10-10-10-2，颜色为归一化的 8 位整数
+// 归一化由顶点拉取完成，这里只需要还原位置：position = aPos.xyz * positionScale + positionOffset
+layout (location = 0) in vec4 aPos;
+layout (location = 1) in vec4 aNormal;
+layout (location = 2) in vec4 aColor;
+
+layout (std140) uniform PerObject
+{
+   vec4 positionScale;
+   vec4 positionOffset;
+};
+
+#include "MeshLighting.glsl"
+
+out vec3 ourColor;
+
+void main()
+{
+   gl_Position = vec4(aPos.xyz * positionScale.xyz + positionOffset.xyz, 1.0);
+   ourColor = shadeVertex(aNormal.xyz, aColor.rgb);
+}
@@ -3,10 +3,24 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aColor;
 
+#ifdef GL_SPIRV
+// 与 ShaderVariants 中 feature 的下标一致，GLSL 路径下由宏定义，没有定义时取相同的默认值
+layout (constant_id = 0) const int USE_VERTEX_COLOR = 0;
+#elif !defined(USE_VERTEX_COLOR)
+#define USE_VERTEX_COLOR 0
+#endif
+
 out vec3 ourColor;
 
 void main()
 {
    gl_Position = vec4(aPos.x, aPos.y, aPos.z, 1.0);
-   ourColor = aColor;
+   if (USE_VERTEX_COLOR != 0)
+   {
+      ourColor = aColor;
+   }
+   else
+   {
+      ourColor = vec3(1.0, 1.0, 1.0);
+   }
 }
\ No newline at end of file
@@ -0,0 +1,31 @@
+#include "EmbeddedFiles.h"
+#include "EmbeddedShaders.h"
+#include <cstring>
+
+bool isEmbeddedPath(const std::string& path)
+{
+    return path.compare(0, strlen(EMBEDDED_PATH_PREFIX), EMBEDDED_PATH_PREFIX) == 0;
+}
+
+std::string getEmbeddedPath(const EmbeddedFile& file)
+{
+    return std::string(EMBEDDED_PATH_PREFIX) + file.path;
+}
+
+const EmbeddedFile* findEmbeddedFile(const std::string& path)
+{
+    if (!isEmbeddedPath(path))
+    {
+        return nullptr;
+    }
+    // 文件数量很少，直接线性查找
+    const char* relativePath = path.c_str() + strlen(EMBEDDED_PATH_PREFIX);
+    for (size_t i = 0; i < kEmbeddedFileCount; ++i)
+    {
+        if (strcmp(kEmbeddedFiles[i]->path, relativePath) == 0)
+        {
+            return kEmbeddedFiles[i];
+        }
+    }
+    return nullptr;
+}
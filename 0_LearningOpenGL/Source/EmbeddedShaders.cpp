@@ -0,0 +1,280 @@
+// 由 Tools/EmbedShaders.py 根据 Shader/ 目录生成，不要手动修改
+#include "EmbeddedShaders.h"
+
+namespace
+{
+    // Shader/FallbackShader.frag
+    constexpr char kFallbackShader_frag[] = {
+        '\x23', '\x76', '\x65', '\x72', '\x73', '\x69', '\x6f', '\x6e', '\x20', '\x33', '\x33', '\x30', '\x20', '\x63', '\x6f', '\x72',
+        '\x65', '\x0a', '\x0a', '\x6f', '\x75', '\x74', '\x20', '\x76', '\x65', '\x63', '\x34', '\x20', '\x66', '\x72', '\x61', '\x67',
+        '\x43', '\x6f', '\x6c', '\x6f', '\x72', '\x3b', '\x0a', '\x2f', '\x2f', '\x20', '\xe7', '\x94', '\xb1', '\x20', '\x55', '\x6e',
+        '\x69', '\x66', '\x6f', '\x72', '\x6d', '\x3c', '\x56', '\x65', '\x63', '\x33', '\x3e', '\x20', '\xe6', '\xaf', '\x8f', '\xe5',
+        '\xb8', '\xa7', '\xe8', '\xae', '\xbe', '\xe7', '\xbd', '\xae', '\xef', '\xbc', '\x8c', '\xe9', '\x9a', '\x8f', '\xe6', '\x97',
+        '\xb6', '\xe9', '\x97', '\xb4', '\xe6', '\x98', '\x8e', '\xe6', '\x9a', '\x97', '\xe5', '\x8f', '\x98', '\xe5', '\x8c', '\x96',
+        '\xef', '\xbc', '\x8c', '\xe8', '\xa1', '\xa8', '\xe7', '\xa4', '\xba', '\xe6', '\xad', '\xa3', '\xe5', '\xbc', '\x8f', '\xe7',
+        '\x9a', '\x84', '\x20', '\x70', '\x72', '\x6f', '\x67', '\x72', '\x61', '\x6d', '\x20', '\xe8', '\xbf', '\x98', '\xe5', '\x9c',
+        '\xa8', '\xe7', '\xbc', '\x96', '\xe8', '\xaf', '\x91', '\x0a', '\x75', '\x6e', '\x69', '\x66', '\x6f', '\x72', '\x6d', '\x20',
+        '\x76', '\x65', '\x63', '\x33', '\x20', '\x66', '\x61', '\x6c', '\x6c', '\x62', '\x61', '\x63', '\x6b', '\x43', '\x6f', '\x6c',
+        '\x6f', '\x72', '\x3b', '\x0a', '\x0a', '\x2f', '\x2f', '\x20', '\xe6', '\xad', '\xa3', '\xe5', '\xbc', '\x8f', '\xe7', '\x9a',
+        '\x84', '\x20', '\x70', '\x72', '\x6f', '\x67', '\x72', '\x61', '\x6d', '\x20', '\xe7', '\xbc', '\x96', '\xe8', '\xaf', '\x91',
+        '\xe5', '\xae', '\x8c', '\xe6', '\x88', '\x90', '\xe4', '\xb9', '\x8b', '\xe5', '\x89', '\x8d', '\xe4', '\xbd', '\xbf', '\xe7',
+        '\x94', '\xa8', '\xe7', '\x9a', '\x84', '\xe7', '\xba', '\xaf', '\xe8', '\x89', '\xb2', '\x20', '\x73', '\x68', '\x61', '\x64',
+        '\x65', '\x72', '\x0a', '\x76', '\x6f', '\x69', '\x64', '\x20', '\x6d', '\x61', '\x69', '\x6e', '\x28', '\x29', '\x0a', '\x7b',
+        '\x0a', '\x09', '\x66', '\x72', '\x61', '\x67', '\x43', '\x6f', '\x6c', '\x6f', '\x72', '\x20', '\x3d', '\x20', '\x76', '\x65',
+        '\x63', '\x34', '\x28', '\x66', '\x61', '\x6c', '\x6c', '\x62', '\x61', '\x63', '\x6b', '\x43', '\x6f', '\x6c', '\x6f', '\x72',
+        '\x2c', '\x20', '\x31', '\x2e', '\x30', '\x29', '\x3b', '\x0a', '\x7d',
+    };
+    constexpr size_t kFallbackShader_fragSize = 281;
+    // Shader/FallbackShader.vert
+    constexpr char kFallbackShader_vert[] = {
+        '\x23', '\x76', '\x65', '\x72', '\x73', '\x69', '\x6f', '\x6e', '\x20', '\x33', '\x33', '\x30', '\x20', '\x63', '\x6f', '\x72',
+        '\x65', '\x0a', '\x0a', '\x6c', '\x61', '\x79', '\x6f', '\x75', '\x74', '\x20', '\x28', '\x6c', '\x6f', '\x63', '\x61', '\x74',
+        '\x69', '\x6f', '\x6e', '\x20', '\x3d', '\x20', '\x30', '\x29', '\x20', '\x69', '\x6e', '\x20', '\x76', '\x65', '\x63', '\x33',
+        '\x20', '\x61', '\x50', '\x6f', '\x73', '\x3b', '\x0a', '\x0a', '\x76', '\x6f', '\x69', '\x64', '\x20', '\x6d', '\x61', '\x69',
+        '\x6e', '\x28', '\x29', '\x0a', '\x7b', '\x0a', '\x20', '\x20', '\x20', '\x67', '\x6c', '\x5f', '\x50', '\x6f', '\x73', '\x69',
+        '\x74', '\x69', '\x6f', '\x6e', '\x20', '\x3d', '\x20', '\x76', '\x65', '\x63', '\x34', '\x28', '\x61', '\x50', '\x6f', '\x73',
+        '\x2e', '\x78', '\x2c', '\x20', '\x61', '\x50', '\x6f', '\x73', '\x2e', '\x79', '\x2c', '\x20', '\x61', '\x50', '\x6f', '\x73',
+        '\x2e', '\x7a', '\x2c', '\x20', '\x31', '\x2e', '\x30', '\x29', '\x3b', '\x0a', '\x7d',
+    };
+    constexpr size_t kFallbackShader_vertSize = 123;
+    // Shader/FragmentShader.frag
+    constexpr char kFragmentShader_frag[] = {
+        '\x23', '\x76', '\x65', '\x72', '\x73', '\x69', '\x6f', '\x6e', '\x20', '\x33', '\x33', '\x30', '\x20', '\x63', '\x6f', '\x72',
+        '\x65', '\x0a', '\x0a', '\x6f', '\x75', '\x74', '\x20', '\x76', '\x65', '\x63', '\x34', '\x20', '\x66', '\x72', '\x61', '\x67',
+        '\x43', '\x6f', '\x6c', '\x6f', '\x72', '\x3b', '\x0a', '\x69', '\x6e', '\x20', '\x76', '\x65', '\x63', '\x33', '\x20', '\x6f',
+        '\x75', '\x72', '\x43', '\x6f', '\x6c', '\x6f', '\x72', '\x3b', '\x0a', '\x6c', '\x61', '\x79', '\x6f', '\x75', '\x74', '\x20',
+        '\x28', '\x73', '\x74', '\x64', '\x31', '\x34', '\x30', '\x29', '\x20', '\x75', '\x6e', '\x69', '\x66', '\x6f', '\x72', '\x6d',
+        '\x20', '\x50', '\x65', '\x72', '\x46', '\x72', '\x61', '\x6d', '\x65', '\x0a', '\x7b', '\x0a', '\x09', '\x66', '\x6c', '\x6f',
+        '\x61', '\x74', '\x20', '\x72', '\x61', '\x74', '\x69', '\x6f', '\x3b', '\x0a', '\x7d', '\x3b', '\x0a', '\x0a', '\x76', '\x6f',
+        '\x69', '\x64', '\x20', '\x6d', '\x61', '\x69', '\x6e', '\x28', '\x29', '\x0a', '\x7b', '\x0a', '\x09', '\x66', '\x72', '\x61',
+        '\x67', '\x43', '\x6f', '\x6c', '\x6f', '\x72', '\x20', '\x3d', '\x20', '\x76', '\x65', '\x63', '\x34', '\x28', '\x6f', '\x75',
+        '\x72', '\x43', '\x6f', '\x6c', '\x6f', '\x72', '\x20', '\x2a', '\x20', '\x72', '\x61', '\x74', '\x69', '\x6f', '\x2c', '\x20',
+        '\x31', '\x2e', '\x30', '\x29', '\x3b', '\x0a', '\x7d',
+    };
+    constexpr size_t kFragmentShader_fragSize = 167;
+    // Shader/InstancedShader.frag
+    constexpr char kInstancedShader_frag[] = {
+        '\x23', '\x76', '\x65', '\x72', '\x73', '\x69', '\x6f', '\x6e', '\x20', '\x33', '\x33', '\x30', '\x20', '\x63', '\x6f', '\x72',
+        '\x65', '\x0a', '\x0a', '\x6f', '\x75', '\x74', '\x20', '\x76', '\x65', '\x63', '\x34', '\x20', '\x66', '\x72', '\x61', '\x67',
+        '\x43', '\x6f', '\x6c', '\x6f', '\x72', '\x3b', '\x0a', '\x69', '\x6e', '\x20', '\x76', '\x65', '\x63', '\x33', '\x20', '\x6f',
+        '\x75', '\x72', '\x43', '\x6f', '\x6c', '\x6f', '\x72', '\x3b', '\x0a', '\x0a', '\x76', '\x6f', '\x69', '\x64', '\x20', '\x6d',
+        '\x61', '\x69', '\x6e', '\x28', '\x29', '\x0a', '\x7b', '\x0a', '\x09', '\x66', '\x72', '\x61', '\x67', '\x43', '\x6f', '\x6c',
+        '\x6f', '\x72', '\x20', '\x3d', '\x20', '\x76', '\x65', '\x63', '\x34', '\x28', '\x6f', '\x75', '\x72', '\x43', '\x6f', '\x6c',
+        '\x6f', '\x72', '\x2c', '\x20', '\x31', '\x2e', '\x30', '\x29', '\x3b', '\x0a', '\x7d',
+    };
+    constexpr size_t kInstancedShader_fragSize = 107;
+    // Shader/InstancedShader.vert
+    constexpr char kInstancedShader_vert[] = {
+        '\x23', '\x76', '\x65', '\x72', '\x73', '\x69', '\x6f', '\x6e', '\x20', '\x33', '\x33', '\x30', '\x20', '\x63', '\x6f', '\x72',
+        '\x65', '\x0a', '\x0a', '\x6c', '\x61', '\x79', '\x6f', '\x75', '\x74', '\x20', '\x28', '\x6c', '\x6f', '\x63', '\x61', '\x74',
+        '\x69', '\x6f', '\x6e', '\x20', '\x3d', '\x20', '\x30', '\x29', '\x20', '\x69', '\x6e', '\x20', '\x76', '\x65', '\x63', '\x33',
+        '\x20', '\x61', '\x50', '\x6f', '\x73', '\x3b', '\x0a', '\x6c', '\x61', '\x79', '\x6f', '\x75', '\x74', '\x20', '\x28', '\x6c',
+        '\x6f', '\x63', '\x61', '\x74', '\x69', '\x6f', '\x6e', '\x20', '\x3d', '\x20', '\x31', '\x29', '\x20', '\x69', '\x6e', '\x20',
+        '\x76', '\x65', '\x63', '\x33', '\x20', '\x61', '\x43', '\x6f', '\x6c', '\x6f', '\x72', '\x3b', '\x0a', '\x2f', '\x2f', '\x20',
+        '\xe6', '\xaf', '\x8f', '\xe4', '\xb8', '\xaa', '\xe5', '\xae', '\x9e', '\xe4', '\xbe', '\x8b', '\xe4', '\xb8', '\x80', '\xe4',
+        '\xbb', '\xbd', '\xef', '\xbc', '\x88', '\x67', '\x6c', '\x56', '\x65', '\x72', '\x74', '\x65', '\x78', '\x41', '\x74', '\x74',
+        '\x72', '\x69', '\x62', '\x44', '\x69', '\x76', '\x69', '\x73', '\x6f', '\x72', '\x20', '\x3d', '\x20', '\x31', '\xef', '\xbc',
+        '\x89', '\xef', '\xbc', '\x9a', '\x78', '\x79', '\x20', '\xe5', '\xb9', '\xb3', '\xe7', '\xa7', '\xbb', '\xe3', '\x80', '\x81',
+        '\xe7', '\xbc', '\xa9', '\xe6', '\x94', '\xbe', '\xe3', '\x80', '\x81', '\xe6', '\x97', '\x8b', '\xe8', '\xbd', '\xac', '\xe8',
+        '\xa7', '\x92', '\xef', '\xbc', '\x88', '\xe5', '\xbc', '\xa7', '\xe5', '\xba', '\xa6', '\xef', '\xbc', '\x89', '\x0a', '\x6c',
+        '\x61', '\x79', '\x6f', '\x75', '\x74', '\x20', '\x28', '\x6c', '\x6f', '\x63', '\x61', '\x74', '\x69', '\x6f', '\x6e', '\x20',
+        '\x3d', '\x20', '\x32', '\x29', '\x20', '\x69', '\x6e', '\x20', '\x76', '\x65', '\x63', '\x34', '\x20', '\x61', '\x49', '\x6e',
+        '\x73', '\x74', '\x61', '\x6e', '\x63', '\x65', '\x54', '\x72', '\x61', '\x6e', '\x73', '\x66', '\x6f', '\x72', '\x6d', '\x3b',
+        '\x0a', '\x6c', '\x61', '\x79', '\x6f', '\x75', '\x74', '\x20', '\x28', '\x6c', '\x6f', '\x63', '\x61', '\x74', '\x69', '\x6f',
+        '\x6e', '\x20', '\x3d', '\x20', '\x33', '\x29', '\x20', '\x69', '\x6e', '\x20', '\x76', '\x65', '\x63', '\x33', '\x20', '\x61',
+        '\x49', '\x6e', '\x73', '\x74', '\x61', '\x6e', '\x63', '\x65', '\x43', '\x6f', '\x6c', '\x6f', '\x72', '\x3b', '\x0a', '\x6c',
+        '\x61', '\x79', '\x6f', '\x75', '\x74', '\x20', '\x28', '\x6c', '\x6f', '\x63', '\x61', '\x74', '\x69', '\x6f', '\x6e', '\x20',
+        '\x3d', '\x20', '\x34', '\x29', '\x20', '\x69', '\x6e', '\x20', '\x66', '\x6c', '\x6f', '\x61', '\x74', '\x20', '\x61', '\x49',
+        '\x6e', '\x73', '\x74', '\x61', '\x6e', '\x63', '\x65', '\x52', '\x61', '\x74', '\x69', '\x6f', '\x3b', '\x0a', '\x0a', '\x6f',
+        '\x75', '\x74', '\x20', '\x76', '\x65', '\x63', '\x33', '\x20', '\x6f', '\x75', '\x72', '\x43', '\x6f', '\x6c', '\x6f', '\x72',
+        '\x3b', '\x0a', '\x0a', '\x76', '\x6f', '\x69', '\x64', '\x20', '\x6d', '\x61', '\x69', '\x6e', '\x28', '\x29', '\x0a', '\x7b',
+        '\x0a', '\x20', '\x20', '\x20', '\x66', '\x6c', '\x6f', '\x61', '\x74', '\x20', '\x73', '\x20', '\x3d', '\x20', '\x73', '\x69',
+        '\x6e', '\x28', '\x61', '\x49', '\x6e', '\x73', '\x74', '\x61', '\x6e', '\x63', '\x65', '\x54', '\x72', '\x61', '\x6e', '\x73',
+        '\x66', '\x6f', '\x72', '\x6d', '\x2e', '\x77', '\x29', '\x3b', '\x0a', '\x20', '\x20', '\x20', '\x66', '\x6c', '\x6f', '\x61',
+        '\x74', '\x20', '\x63', '\x20', '\x3d', '\x20', '\x63', '\x6f', '\x73', '\x28', '\x61', '\x49', '\x6e', '\x73', '\x74', '\x61',
+        '\x6e', '\x63', '\x65', '\x54', '\x72', '\x61', '\x6e', '\x73', '\x66', '\x6f', '\x72', '\x6d', '\x2e', '\x77', '\x29', '\x3b',
+        '\x0a', '\x20', '\x20', '\x20', '\x76', '\x65', '\x63', '\x32', '\x20', '\x70', '\x6f', '\x73', '\x69', '\x74', '\x69', '\x6f',
+        '\x6e', '\x20', '\x3d', '\x20', '\x6d', '\x61', '\x74', '\x32', '\x28', '\x63', '\x2c', '\x20', '\x73', '\x2c', '\x20', '\x2d',
+        '\x73', '\x2c', '\x20', '\x63', '\x29', '\x20', '\x2a', '\x20', '\x61', '\x50', '\x6f', '\x73', '\x2e', '\x78', '\x79', '\x20',
+        '\x2a', '\x20', '\x61', '\x49', '\x6e', '\x73', '\x74', '\x61', '\x6e', '\x63', '\x65', '\x54', '\x72', '\x61', '\x6e', '\x73',
+        '\x66', '\x6f', '\x72', '\x6d', '\x2e', '\x7a', '\x20', '\x2b', '\x20', '\x61', '\x49', '\x6e', '\x73', '\x74', '\x61', '\x6e',
+        '\x63', '\x65', '\x54', '\x72', '\x61', '\x6e', '\x73', '\x66', '\x6f', '\x72', '\x6d', '\x2e', '\x78', '\x79', '\x3b', '\x0a',
+        '\x20', '\x20', '\x20', '\x67', '\x6c', '\x5f', '\x50', '\x6f', '\x73', '\x69', '\x74', '\x69', '\x6f', '\x6e', '\x20', '\x3d',
+        '\x20', '\x76', '\x65', '\x63', '\x34', '\x28', '\x70', '\x6f', '\x73', '\x69', '\x74', '\x69', '\x6f', '\x6e', '\x2c', '\x20',
+        '\x61', '\x50', '\x6f', '\x73', '\x2e', '\x7a', '\x2c', '\x20', '\x31', '\x2e', '\x30', '\x29', '\x3b', '\x0a', '\x20', '\x20',
+        '\x20', '\x6f', '\x75', '\x72', '\x43', '\x6f', '\x6c', '\x6f', '\x72', '\x20', '\x3d', '\x20', '\x61', '\x43', '\x6f', '\x6c',
+        '\x6f', '\x72', '\x20', '\x2a', '\x20', '\x61', '\x49', '\x6e', '\x73', '\x74', '\x61', '\x6e', '\x63', '\x65', '\x43', '\x6f',
+        '\x6c', '\x6f', '\x72', '\x20', '\x2a', '\x20', '\x61', '\x49', '\x6e', '\x73', '\x74', '\x61', '\x6e', '\x63', '\x65', '\x52',
+        '\x61', '\x74', '\x69', '\x6f', '\x3b', '\x0a', '\x7d',
+    };
+    constexpr size_t kInstancedShader_vertSize = 647;
+    // Shader/MeshLighting.glsl
+    constexpr char kMeshLighting_glsl[] = {
+        '\x23', '\x70', '\x72', '\x61', '\x67', '\x6d', '\x61', '\x20', '\x6f', '\x6e', '\x63', '\x65', '\x0a', '\x0a', '\x2f', '\x2f',
+        '\x20', '\xe5', '\x9b', '\xba', '\xe5', '\xae', '\x9a', '\xe6', '\x96', '\xb9', '\xe5', '\x90', '\x91', '\xe5', '\x85', '\x89',
+        '\xe7', '\x9a', '\x84', '\xe6', '\xbc', '\xab', '\xe5', '\x8f', '\x8d', '\xe5', '\xb0', '\x84', '\xef', '\xbc', '\x8c', '\xe9',
+        '\x87', '\x8f', '\xe5', '\x8c', '\x96', '\xe5', '\x92', '\x8c', '\xe6', '\x9c', '\xaa', '\xe9', '\x87', '\x8f', '\xe5', '\x8c',
+        '\x96', '\xe7', '\x9a', '\x84', '\x20', '\x6d', '\x65', '\x73', '\x68', '\x20', '\xe5', '\x85', '\xb1', '\xe7', '\x94', '\xa8',
+        '\xef', '\xbc', '\x8c', '\xe4', '\xbf', '\x9d', '\xe8', '\xaf', '\x81', '\xe4', '\xb8', '\xa4', '\xe8', '\x80', '\x85', '\xe7',
+        '\x94', '\xbb', '\xe5', '\x87', '\xba', '\xe7', '\x9b', '\xb8', '\xe5', '\x90', '\x8c', '\xe7', '\x9a', '\x84', '\xe7', '\xbb',
+        '\x93', '\xe6', '\x9e', '\x9c', '\x0a', '\x76', '\x65', '\x63', '\x33', '\x20', '\x73', '\x68', '\x61', '\x64', '\x65', '\x56',
+        '\x65', '\x72', '\x74', '\x65', '\x78', '\x28', '\x76', '\x65', '\x63', '\x33', '\x20', '\x6e', '\x6f', '\x72', '\x6d', '\x61',
+        '\x6c', '\x2c', '\x20', '\x76', '\x65', '\x63', '\x33', '\x20', '\x63', '\x6f', '\x6c', '\x6f', '\x72', '\x29', '\x0a', '\x7b',
+        '\x0a', '\x20', '\x20', '\x20', '\x76', '\x65', '\x63', '\x33', '\x20', '\x6c', '\x69', '\x67', '\x68', '\x74', '\x44', '\x69',
+        '\x72', '\x65', '\x63', '\x74', '\x69', '\x6f', '\x6e', '\x20', '\x3d', '\x20', '\x6e', '\x6f', '\x72', '\x6d', '\x61', '\x6c',
+        '\x69', '\x7a', '\x65', '\x28', '\x76', '\x65', '\x63', '\x33', '\x28', '\x30', '\x2e', '\x33', '\x2c', '\x20', '\x30', '\x2e',
+        '\x35', '\x2c', '\x20', '\x31', '\x2e', '\x30', '\x29', '\x29', '\x3b', '\x0a', '\x20', '\x20', '\x20', '\x72', '\x65', '\x74',
+        '\x75', '\x72', '\x6e', '\x20', '\x63', '\x6f', '\x6c', '\x6f', '\x72', '\x20', '\x2a', '\x20', '\x28', '\x30', '\x2e', '\x32',
+        '\x20', '\x2b', '\x20', '\x30', '\x2e', '\x38', '\x20', '\x2a', '\x20', '\x6d', '\x61', '\x78', '\x28', '\x64', '\x6f', '\x74',
+        '\x28', '\x6e', '\x6f', '\x72', '\x6d', '\x61', '\x6c', '\x69', '\x7a', '\x65', '\x28', '\x6e', '\x6f', '\x72', '\x6d', '\x61',
+        '\x6c', '\x29', '\x2c', '\x20', '\x6c', '\x69', '\x67', '\x68', '\x74', '\x44', '\x69', '\x72', '\x65', '\x63', '\x74', '\x69',
+        '\x6f', '\x6e', '\x29', '\x2c', '\x20', '\x30', '\x2e', '\x30', '\x29', '\x29', '\x3b', '\x0a', '\x7d', '\x0a',
+    };
+    constexpr size_t kMeshLighting_glslSize = 302;
+    // Shader/MeshShader.frag
+    constexpr char kMeshShader_frag[] = {
+        '\x23', '\x76', '\x65', '\x72', '\x73', '\x69', '\x6f', '\x6e', '\x20', '\x33', '\x33', '\x30', '\x20', '\x63', '\x6f', '\x72',
+        '\x65', '\x0a', '\x0a', '\x6f', '\x75', '\x74', '\x20', '\x76', '\x65', '\x63', '\x34', '\x20', '\x66', '\x72', '\x61', '\x67',
+        '\x43', '\x6f', '\x6c', '\x6f', '\x72', '\x3b', '\x0a', '\x69', '\x6e', '\x20', '\x76', '\x65', '\x63', '\x33', '\x20', '\x6f',
+        '\x75', '\x72', '\x43', '\x6f', '\x6c', '\x6f', '\x72', '\x3b', '\x0a', '\x0a', '\x76', '\x6f', '\x69', '\x64', '\x20', '\x6d',
+        '\x61', '\x69', '\x6e', '\x28', '\x29', '\x0a', '\x7b', '\x0a', '\x09', '\x66', '\x72', '\x61', '\x67', '\x43', '\x6f', '\x6c',
+        '\x6f', '\x72', '\x20', '\x3d', '\x20', '\x76', '\x65', '\x63', '\x34', '\x28', '\x6f', '\x75', '\x72', '\x43', '\x6f', '\x6c',
+        '\x6f', '\x72', '\x2c', '\x20', '\x31', '\x2e', '\x30', '\x29', '\x3b', '\x0a', '\x7d', '\x0a',
+    };
+    constexpr size_t kMeshShader_fragSize = 108;
+    // Shader/MeshShader.vert
+    constexpr char kMeshShader_vert[] = {
+        '\x23', '\x76', '\x65', '\x72', '\x73', '\x69', '\x6f', '\x6e', '\x20', '\x33', '\x33', '\x30', '\x20', '\x63', '\x6f', '\x72',
+        '\x65', '\x0a', '\x0a', '\x6c', '\x61', '\x79', '\x6f', '\x75', '\x74', '\x20', '\x28', '\x6c', '\x6f', '\x63', '\x61', '\x74',
+        '\x69', '\x6f', '\x6e', '\x20', '\x3d', '\x20', '\x30', '\x29', '\x20', '\x69', '\x6e', '\x20', '\x76', '\x65', '\x63', '\x33',
+        '\x20', '\x61', '\x50', '\x6f', '\x73', '\x3b', '\x0a', '\x6c', '\x61', '\x79', '\x6f', '\x75', '\x74', '\x20', '\x28', '\x6c',
+        '\x6f', '\x63', '\x61', '\x74', '\x69', '\x6f', '\x6e', '\x20', '\x3d', '\x20', '\x31', '\x29', '\x20', '\x69', '\x6e', '\x20',
+        '\x76', '\x65', '\x63', '\x33', '\x20', '\x61', '\x4e', '\x6f', '\x72', '\x6d', '\x61', '\x6c', '\x3b', '\x0a', '\x6c', '\x61',
+        '\x79', '\x6f', '\x75', '\x74', '\x20', '\x28', '\x6c', '\x6f', '\x63', '\x61', '\x74', '\x69', '\x6f', '\x6e', '\x20', '\x3d',
+        '\x20', '\x32', '\x29', '\x20', '\x69', '\x6e', '\x20', '\x76', '\x65', '\x63', '\x33', '\x20', '\x61', '\x43', '\x6f', '\x6c',
+        '\x6f', '\x72', '\x3b', '\x0a', '\x0a', '\x23', '\x69', '\x6e', '\x63', '\x6c', '\x75', '\x64', '\x65', '\x20', '\x22', '\x4d',
+        '\x65', '\x73', '\x68', '\x4c', '\x69', '\x67', '\x68', '\x74', '\x69', '\x6e', '\x67', '\x2e', '\x67', '\x6c', '\x73', '\x6c',
+        '\x22', '\x0a', '\x0a', '\x6f', '\x75', '\x74', '\x20', '\x76', '\x65', '\x63', '\x33', '\x20', '\x6f', '\x75', '\x72', '\x43',
+        '\x6f', '\x6c', '\x6f', '\x72', '\x3b', '\x0a', '\x0a', '\x76', '\x6f', '\x69', '\x64', '\x20', '\x6d', '\x61', '\x69', '\x6e',
+        '\x28', '\x29', '\x0a', '\x7b', '\x0a', '\x20', '\x20', '\x20', '\x67', '\x6c', '\x5f', '\x50', '\x6f', '\x73', '\x69', '\x74',
+        '\x69', '\x6f', '\x6e', '\x20', '\x3d', '\x20', '\x76', '\x65', '\x63', '\x34', '\x28', '\x61', '\x50', '\x6f', '\x73', '\x2c',
+        '\x20', '\x31', '\x2e', '\x30', '\x29', '\x3b', '\x0a', '\x20', '\x20', '\x20', '\x6f', '\x75', '\x72', '\x43', '\x6f', '\x6c',
+        '\x6f', '\x72', '\x20', '\x3d', '\x20', '\x73', '\x68', '\x61', '\x64', '\x65', '\x56', '\x65', '\x72', '\x74', '\x65', '\x78',
+        '\x28', '\x61', '\x4e', '\x6f', '\x72', '\x6d', '\x61', '\x6c', '\x2c', '\x20', '\x61', '\x43', '\x6f', '\x6c', '\x6f', '\x72',
+        '\x29', '\x3b', '\x0a', '\x7d', '\x0a',
+    };
+    constexpr size_t kMeshShader_vertSize = 277;
+    // Shader/QuantizedMeshShader.vert
+    constexpr char kQuantizedMeshShader_vert[] = {
+        '\x23', '\x76', '\x65', '\x72', '\x73', '\x69', '\x6f', '\x6e', '\x20', '\x33', '\x33', '\x30', '\x20', '\x63', '\x6f', '\x72',
+        '\x65', '\x0a', '\x0a', '\x2f', '\x2f', '\x20', '\xe4', '\xbd', '\x8d', '\xe7', '\xbd', '\xae', '\xe4', '\xb8', '\xba', '\x20',
+        '\x31', '\x36', '\x20', '\xe4', '\xbd', '\x8d', '\xef', '\xbc', '\x88', '\x68', '\x61', '\x6c', '\x66', '\x20', '\xe6', '\x88',
+        '\x96', '\xe5', '\xbd', '\x92', '\xe4', '\xb8', '\x80', '\xe5', '\x8c', '\x96', '\xe6', '\x95', '\xb4', '\xe6', '\x95', '\xb0',
+        '\xef', '\xbc', '\x89', '\xef', '\xbc', '\x8c', '\xe6', '\xb3', '\x95', '\xe7', '\xba', '\xbf', '\xe4', '\xb8', '\xba', '\x20',
+        '\x31', '\x30', '\x2d', '\x31', '\x30', '\x2d', '\x31', '\x30', '\x2d', '\x32', '\xef', '\xbc', '\x8c', '\xe9', '\xa2', '\x9c',
+        '\xe8', '\x89', '\xb2', '\xe4', '\xb8', '\xba', '\xe5', '\xbd', '\x92', '\xe4', '\xb8', '\x80', '\xe5', '\x8c', '\x96', '\xe7',
+        '\x9a', '\x84', '\x20', '\x38', '\x20', '\xe4', '\xbd', '\x8d', '\xe6', '\x95', '\xb4', '\xe6', '\x95', '\xb0', '\x0a', '\x2f',
+        '\x2f', '\x20', '\xe5', '\xbd', '\x92', '\xe4', '\xb8', '\x80', '\xe5', '\x8c', '\x96', '\xe7', '\x94', '\xb1', '\xe9', '\xa1',
+        '\xb6', '\xe7', '\x82', '\xb9', '\xe6', '\x8b', '\x89', '\xe5', '\x8f', '\x96', '\xe5', '\xae', '\x8c', '\xe6', '\x88', '\x90',
+        '\xef', '\xbc', '\x8c', '\xe8', '\xbf', '\x99', '\xe9', '\x87', '\x8c', '\xe5', '\x8f', '\xaa', '\xe9', '\x9c', '\x80', '\xe8',
+        '\xa6', '\x81', '\xe8', '\xbf', '\x98', '\xe5', '\x8e', '\x9f', '\xe4', '\xbd', '\x8d', '\xe7', '\xbd', '\xae', '\xef', '\xbc',
+        '\x9a', '\x70', '\x6f', '\x73', '\x69', '\x74', '\x69', '\x6f', '\x6e', '\x20', '\x3d', '\x20', '\x61', '\x50', '\x6f', '\x73',
+        '\x2e', '\x78', '\x79', '\x7a', '\x20', '\x2a', '\x20', '\x70', '\x6f', '\x73', '\x69', '\x74', '\x69', '\x6f', '\x6e', '\x53',
+        '\x63', '\x61', '\x6c', '\x65', '\x20', '\x2b', '\x20', '\x70', '\x6f', '\x73', '\x69', '\x74', '\x69', '\x6f', '\x6e', '\x4f',
+        '\x66', '\x66', '\x73', '\x65', '\x74', '\x0a', '\x6c', '\x61', '\x79', '\x6f', '\x75', '\x74', '\x20', '\x28', '\x6c', '\x6f',
+        '\x63', '\x61', '\x74', '\x69', '\x6f', '\x6e', '\x20', '\x3d', '\x20', '\x30', '\x29', '\x20', '\x69', '\x6e', '\x20', '\x76',
+        '\x65', '\x63', '\x34', '\x20', '\x61', '\x50', '\x6f', '\x73', '\x3b', '\x0a', '\x6c', '\x61', '\x79', '\x6f', '\x75', '\x74',
+        '\x20', '\x28', '\x6c', '\x6f', '\x63', '\x61', '\x74', '\x69', '\x6f', '\x6e', '\x20', '\x3d', '\x20', '\x31', '\x29', '\x20',
+        '\x69', '\x6e', '\x20', '\x76', '\x65', '\x63', '\x34', '\x20', '\x61', '\x4e', '\x6f', '\x72', '\x6d', '\x61', '\x6c', '\x3b',
+        '\x0a', '\x6c', '\x61', '\x79', '\x6f', '\x75', '\x74', '\x20', '\x28', '\x6c', '\x6f', '\x63', '\x61', '\x74', '\x69', '\x6f',
+        '\x6e', '\x20', '\x3d', '\x20', '\x32', '\x29', '\x20', '\x69', '\x6e', '\x20', '\x76', '\x65', '\x63', '\x34', '\x20', '\x61',
+        '\x43', '\x6f', '\x6c', '\x6f', '\x72', '\x3b', '\x0a', '\x0a', '\x6c', '\x61', '\x79', '\x6f', '\x75', '\x74', '\x20', '\x28',
+        '\x73', '\x74', '\x64', '\x31', '\x34', '\x30', '\x29', '\x20', '\x75', '\x6e', '\x69', '\x66', '\x6f', '\x72', '\x6d', '\x20',
+        '\x50', '\x65', '\x72', '\x4f', '\x62', '\x6a', '\x65', '\x63', '\x74', '\x0a', '\x7b', '\x0a', '\x20', '\x20', '\x20', '\x76',
+        '\x65', '\x63', '\x34', '\x20', '\x70', '\x6f', '\x73', '\x69', '\x74', '\x69', '\x6f', '\x6e', '\x53', '\x63', '\x61', '\x6c',
+        '\x65', '\x3b', '\x0a', '\x20', '\x20', '\x20', '\x76', '\x65', '\x63', '\x34', '\x20', '\x70', '\x6f', '\x73', '\x69', '\x74',
+        '\x69', '\x6f', '\x6e', '\x4f', '\x66', '\x66', '\x73', '\x65', '\x74', '\x3b', '\x0a', '\x7d', '\x3b', '\x0a', '\x0a', '\x23',
+        '\x69', '\x6e', '\x63', '\x6c', '\x75', '\x64', '\x65', '\x20', '\x22', '\x4d', '\x65', '\x73', '\x68', '\x4c', '\x69', '\x67',
+        '\x68', '\x74', '\x69', '\x6e', '\x67', '\x2e', '\x67', '\x6c', '\x73', '\x6c', '\x22', '\x0a', '\x0a', '\x6f', '\x75', '\x74',
+        '\x20', '\x76', '\x65', '\x63', '\x33', '\x20', '\x6f', '\x75', '\x72', '\x43', '\x6f', '\x6c', '\x6f', '\x72', '\x3b', '\x0a',
+        '\x0a', '\x76', '\x6f', '\x69', '\x64', '\x20', '\x6d', '\x61', '\x69', '\x6e', '\x28', '\x29', '\x0a', '\x7b', '\x0a', '\x20',
+        '\x20', '\x20', '\x67', '\x6c', '\x5f', '\x50', '\x6f', '\x73', '\x69', '\x74', '\x69', '\x6f', '\x6e', '\x20', '\x3d', '\x20',
+        '\x76', '\x65', '\x63', '\x34', '\x28', '\x61', '\x50', '\x6f', '\x73', '\x2e', '\x78', '\x79', '\x7a', '\x20', '\x2a', '\x20',
+        '\x70', '\x6f', '\x73', '\x69', '\x74', '\x69', '\x6f', '\x6e', '\x53', '\x63', '\x61', '\x6c', '\x65', '\x2e', '\x78', '\x79',
+        '\x7a', '\x20', '\x2b', '\x20', '\x70', '\x6f', '\x73', '\x69', '\x74', '\x69', '\x6f', '\x6e', '\x4f', '\x66', '\x66', '\x73',
+        '\x65', '\x74', '\x2e', '\x78', '\x79', '\x7a', '\x2c', '\x20', '\x31', '\x2e', '\x30', '\x29', '\x3b', '\x0a', '\x20', '\x20',
+        '\x20', '\x6f', '\x75', '\x72', '\x43', '\x6f', '\x6c', '\x6f', '\x72', '\x20', '\x3d', '\x20', '\x73', '\x68', '\x61', '\x64',
+        '\x65', '\x56', '\x65', '\x72', '\x74', '\x65', '\x78', '\x28', '\x61', '\x4e', '\x6f', '\x72', '\x6d', '\x61', '\x6c', '\x2e',
+        '\x78', '\x79', '\x7a', '\x2c', '\x20', '\x61', '\x43', '\x6f', '\x6c', '\x6f', '\x72', '\x2e', '\x72', '\x67', '\x62', '\x29',
+        '\x3b', '\x0a', '\x7d', '\x0a',
+    };
+    constexpr size_t kQuantizedMeshShader_vertSize = 644;
+    // Shader/VertexShader.vert
+    constexpr char kVertexShader_vert[] = {
+        '\x23', '\x76', '\x65', '\x72', '\x73', '\x69', '\x6f', '\x6e', '\x20', '\x33', '\x33', '\x30', '\x20', '\x63', '\x6f', '\x72',
+        '\x65', '\x0a', '\x0a', '\x6c', '\x61', '\x79', '\x6f', '\x75', '\x74', '\x20', '\x28', '\x6c', '\x6f', '\x63', '\x61', '\x74',
+        '\x69', '\x6f', '\x6e', '\x20', '\x3d', '\x20', '\x30', '\x29', '\x20', '\x69', '\x6e', '\x20', '\x76', '\x65', '\x63', '\x33',
+        '\x20', '\x61', '\x50', '\x6f', '\x73', '\x3b', '\x0a', '\x6c', '\x61', '\x79', '\x6f', '\x75', '\x74', '\x20', '\x28', '\x6c',
+        '\x6f', '\x63', '\x61', '\x74', '\x69', '\x6f', '\x6e', '\x20', '\x3d', '\x20', '\x31', '\x29', '\x20', '\x69', '\x6e', '\x20',
+        '\x76', '\x65', '\x63', '\x33', '\x20', '\x61', '\x43', '\x6f', '\x6c', '\x6f', '\x72', '\x3b', '\x0a', '\x0a', '\x23', '\x69',
+        '\x66', '\x64', '\x65', '\x66', '\x20', '\x47', '\x4c', '\x5f', '\x53', '\x50', '\x49', '\x52', '\x56', '\x0a', '\x2f', '\x2f',
+        '\x20', '\xe4', '\xb8', '\x8e', '\x20', '\x53', '\x68', '\x61', '\x64', '\x65', '\x72', '\x56', '\x61', '\x72', '\x69', '\x61',
+        '\x6e', '\x74', '\x73', '\x20', '\xe4', '\xb8', '\xad', '\x20', '\x66', '\x65', '\x61', '\x74', '\x75', '\x72', '\x65', '\x20',
+        '\xe7', '\x9a', '\x84', '\xe4', '\xb8', '\x8b', '\xe6', '\xa0', '\x87', '\xe4', '\xb8', '\x80', '\xe8', '\x87', '\xb4', '\xef',
+        '\xbc', '\x8c', '\x47', '\x4c', '\x53', '\x4c', '\x20', '\xe8', '\xb7', '\xaf', '\xe5', '\xbe', '\x84', '\xe4', '\xb8', '\x8b',
+        '\xe7', '\x94', '\xb1', '\xe5', '\xae', '\x8f', '\xe5', '\xae', '\x9a', '\xe4', '\xb9', '\x89', '\xef', '\xbc', '\x8c', '\xe6',
+        '\xb2', '\xa1', '\xe6', '\x9c', '\x89', '\xe5', '\xae', '\x9a', '\xe4', '\xb9', '\x89', '\xe6', '\x97', '\xb6', '\xe5', '\x8f',
+        '\x96', '\xe7', '\x9b', '\xb8', '\xe5', '\x90', '\x8c', '\xe7', '\x9a', '\x84', '\xe9', '\xbb', '\x98', '\xe8', '\xae', '\xa4',
+        '\xe5', '\x80', '\xbc', '\x0a', '\x6c', '\x61', '\x79', '\x6f', '\x75', '\x74', '\x20', '\x28', '\x63', '\x6f', '\x6e', '\x73',
+        '\x74', '\x61', '\x6e', '\x74', '\x5f', '\x69', '\x64', '\x20', '\x3d', '\x20', '\x30', '\x29', '\x20', '\x63', '\x6f', '\x6e',
+        '\x73', '\x74', '\x20', '\x69', '\x6e', '\x74', '\x20', '\x55', '\x53', '\x45', '\x5f', '\x56', '\x45', '\x52', '\x54', '\x45',
+        '\x58', '\x5f', '\x43', '\x4f', '\x4c', '\x4f', '\x52', '\x20', '\x3d', '\x20', '\x30', '\x3b', '\x0a', '\x23', '\x65', '\x6c',
+        '\x69', '\x66', '\x20', '\x21', '\x64', '\x65', '\x66', '\x69', '\x6e', '\x65', '\x64', '\x28', '\x55', '\x53', '\x45', '\x5f',
+        '\x56', '\x45', '\x52', '\x54', '\x45', '\x58', '\x5f', '\x43', '\x4f', '\x4c', '\x4f', '\x52', '\x29', '\x0a', '\x23', '\x64',
+        '\x65', '\x66', '\x69', '\x6e', '\x65', '\x20', '\x55', '\x53', '\x45', '\x5f', '\x56', '\x45', '\x52', '\x54', '\x45', '\x58',
+        '\x5f', '\x43', '\x4f', '\x4c', '\x4f', '\x52', '\x20', '\x30', '\x0a', '\x23', '\x65', '\x6e', '\x64', '\x69', '\x66', '\x0a',
+        '\x0a', '\x6f', '\x75', '\x74', '\x20', '\x76', '\x65', '\x63', '\x33', '\x20', '\x6f', '\x75', '\x72', '\x43', '\x6f', '\x6c',
+        '\x6f', '\x72', '\x3b', '\x0a', '\x0a', '\x76', '\x6f', '\x69', '\x64', '\x20', '\x6d', '\x61', '\x69', '\x6e', '\x28', '\x29',
+        '\x0a', '\x7b', '\x0a', '\x20', '\x20', '\x20', '\x67', '\x6c', '\x5f', '\x50', '\x6f', '\x73', '\x69', '\x74', '\x69', '\x6f',
+        '\x6e', '\x20', '\x3d', '\x20', '\x76', '\x65', '\x63', '\x34', '\x28', '\x61', '\x50', '\x6f', '\x73', '\x2e', '\x78', '\x2c',
+        '\x20', '\x61', '\x50', '\x6f', '\x73', '\x2e', '\x79', '\x2c', '\x20', '\x61', '\x50', '\x6f', '\x73', '\x2e', '\x7a', '\x2c',
+        '\x20', '\x31', '\x2e', '\x30', '\x29', '\x3b', '\x0a', '\x20', '\x20', '\x20', '\x69', '\x66', '\x20', '\x28', '\x55', '\x53',
+        '\x45', '\x5f', '\x56', '\x45', '\x52', '\x54', '\x45', '\x58', '\x5f', '\x43', '\x4f', '\x4c', '\x4f', '\x52', '\x20', '\x21',
+        '\x3d', '\x20', '\x30', '\x29', '\x0a', '\x20', '\x20', '\x20', '\x7b', '\x0a', '\x20', '\x20', '\x20', '\x20', '\x20', '\x20',
+        '\x6f', '\x75', '\x72', '\x43', '\x6f', '\x6c', '\x6f', '\x72', '\x20', '\x3d', '\x20', '\x61', '\x43', '\x6f', '\x6c', '\x6f',
+        '\x72', '\x3b', '\x0a', '\x20', '\x20', '\x20', '\x7d', '\x0a', '\x20', '\x20', '\x20', '\x65', '\x6c', '\x73', '\x65', '\x0a',
+        '\x20', '\x20', '\x20', '\x7b', '\x0a', '\x20', '\x20', '\x20', '\x20', '\x20', '\x20', '\x6f', '\x75', '\x72', '\x43', '\x6f',
+        '\x6c', '\x6f', '\x72', '\x20', '\x3d', '\x20', '\x76', '\x65', '\x63', '\x33', '\x28', '\x31', '\x2e', '\x30', '\x2c', '\x20',
+        '\x31', '\x2e', '\x30', '\x2c', '\x20', '\x31', '\x2e', '\x30', '\x29', '\x3b', '\x0a', '\x20', '\x20', '\x20', '\x7d', '\x0a',
+        '\x7d',
+    };
+    constexpr size_t kVertexShader_vertSize = 561;
+}
+
+namespace EmbeddedShaders
+{
+    constexpr EmbeddedFile FallbackShader_frag = { "Shader/FallbackShader.frag", kFallbackShader_frag, kFallbackShader_fragSize };
+    constexpr EmbeddedFile FallbackShader_vert = { "Shader/FallbackShader.vert", kFallbackShader_vert, kFallbackShader_vertSize };
+    constexpr EmbeddedFile FragmentShader_frag = { "Shader/FragmentShader.frag", kFragmentShader_frag, kFragmentShader_fragSize };
+    constexpr EmbeddedFile InstancedShader_frag = { "Shader/InstancedShader.frag", kInstancedShader_frag, kInstancedShader_fragSize };
+    constexpr EmbeddedFile InstancedShader_vert = { "Shader/InstancedShader.vert", kInstancedShader_vert, kInstancedShader_vertSize };
+    constexpr EmbeddedFile MeshLighting_glsl = { "Shader/MeshLighting.glsl", kMeshLighting_glsl, kMeshLighting_glslSize };
+    constexpr EmbeddedFile MeshShader_frag = { "Shader/MeshShader.frag", kMeshShader_frag, kMeshShader_fragSize };
+    constexpr EmbeddedFile MeshShader_vert = { "Shader/MeshShader.vert", kMeshShader_vert, kMeshShader_vertSize };
+    constexpr EmbeddedFile QuantizedMeshShader_vert = { "Shader/QuantizedMeshShader.vert", kQuantizedMeshShader_vert, kQuantizedMeshShader_vertSize };
+    constexpr EmbeddedFile VertexShader_vert = { "Shader/VertexShader.vert", kVertexShader_vert, kVertexShader_vertSize };
+}
+
+constexpr const EmbeddedFile* kEmbeddedFiles[] = {
+    &EmbeddedShaders::FallbackShader_frag,
+    &EmbeddedShaders::FallbackShader_vert,
+    &EmbeddedShaders::FragmentShader_frag,
+    &EmbeddedShaders::InstancedShader_frag,
+    &EmbeddedShaders::InstancedShader_vert,
+    &EmbeddedShaders::MeshLighting_glsl,
+    &EmbeddedShaders::MeshShader_frag,
+    &EmbeddedShaders::MeshShader_vert,
+    &EmbeddedShaders::QuantizedMeshShader_vert,
+    &EmbeddedShaders::VertexShader_vert,
+};
+constexpr size_t kEmbeddedFileCount = 10;
@@ -0,0 +1,149 @@
+#include "FileWatcher.h"
+#include <chrono>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+FileWatcher& FileWatcher::instance()
+{
+    static FileWatcher watcher;
+    return watcher;
+}
+
+FileWatcher::~FileWatcher()
+{
+    running = false;
+    wakeup.notify_all();
+    if (thread.joinable())
+    {
+        thread.join();
+    }
+#ifdef __linux__
+    if (inotifyFd >= 0)
+    {
+        close(inotifyFd);
+    }
+#endif
+}
+
+void FileWatcher::watch(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (files.count(path) != 0)
+    {
+        return;
+    }
+    files[path] = WatchedFile{ 0, getModifiedTime(path) };
+
+#ifdef __linux__
+    // 编辑器保存时常常先写临时文件再改名，所以监视文件所在的目录而不是文件本身
+    if (inotifyFd < 0)
+    {
+        inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    }
+    if (inotifyFd >= 0)
+    {
+        size_t slash = path.find_last_of('/');
+        std::string directory = slash == std::string::npos ? "." : path.substr(0, slash);
+        int wd = inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+        if (wd >= 0)
+        {
+            directories[wd] = directory;
+        }
+    }
+#endif
+
+    if (!running)
+    {
+        running = true;
+        thread = std::thread(&FileWatcher::run, this);
+    }
+}
+
+unsigned int FileWatcher::getVersion(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = files.find(path);
+    return it != files.end() ? it->second.version : 0;
+}
+
+void FileWatcher::run()
+{
+    while (running)
+    {
+#ifdef __linux__
+        if (inotifyFd >= 0)
+        {
+            pollfd descriptor = { inotifyFd, POLLIN, 0 };
+            if (::poll(&descriptor, 1, 200) <= 0)
+            {
+                continue;
+            }
+
+            alignas(inotify_event) char buffer[4096];
+            ssize_t length;
+            while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (char* cursor = buffer; cursor < buffer + length; )
+                {
+                    const inotify_event* event = (const inotify_event*)cursor;
+                    cursor += sizeof(inotify_event) + event->len;
+                    auto directory = directories.find(event->wd);
+                    if (event->len == 0 || directory == directories.end())
+                    {
+                        continue;
+                    }
+                    std::string path = directory->second == "." ? event->name : directory->second + "/" + event->name;
+                    auto file = files.find(path);
+                    if (file != files.end())
+                    {
+                        ++file->second.version;
+                        ++generation;
+                    }
+                }
+            }
+            continue;
+        }
+#endif
+        pollModifiedTimes();
+        std::unique_lock<std::mutex> lock(mutex);
+        wakeup.wait_for(lock, std::chrono::milliseconds(250), [this] { return !running; });
+    }
+}
+
+void FileWatcher::pollModifiedTimes()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& file : files)
+    {
+        long long modifiedTime = getModifiedTime(file.first);
+        if (modifiedTime != file.second.modifiedTime)
+        {
+            file.second.modifiedTime = modifiedTime;
+            ++file.second.version;
+            ++generation;
+        }
+    }
+}
+
+long long FileWatcher::getModifiedTime(const std::string& path)
+{
+#ifdef _WIN32
+    struct _stat64 info;
+    if (_stat64(path.c_str(), &info) != 0)
+    {
+        return -1;
+    }
+#else
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0)
+    {
+        return -1;
+    }
+#endif
+    return (long long)info.st_mtime;
+}
@@ -0,0 +1,137 @@
+#include "GLExtensions.h"
+#include <cstring>
+
+PFNGLGETPROGRAMBINARYPROC glext_glGetProgramBinary = NULL;
+PFNGLPROGRAMBINARYPROC glext_glProgramBinary = NULL;
+PFNGLPROGRAMPARAMETERIPROC glext_glProgramParameteri = NULL;
+PFNGLMAXSHADERCOMPILERTHREADSKHRPROC glext_glMaxShaderCompilerThreadsKHR = NULL;
+PFNGLBINDVERTEXBUFFERPROC glext_glBindVertexBuffer = NULL;
+PFNGLVERTEXATTRIBFORMATPROC glext_glVertexAttribFormat = NULL;
+PFNGLVERTEXATTRIBIFORMATPROC glext_glVertexAttribIFormat = NULL;
+PFNGLVERTEXATTRIBBINDINGPROC glext_glVertexAttribBinding = NULL;
+PFNGLVERTEXBINDINGDIVISORPROC glext_glVertexBindingDivisor = NULL;
+PFNGLGENPROGRAMPIPELINESPROC glext_glGenProgramPipelines = NULL;
+PFNGLDELETEPROGRAMPIPELINESPROC glext_glDeleteProgramPipelines = NULL;
+PFNGLBINDPROGRAMPIPELINEPROC glext_glBindProgramPipeline = NULL;
+PFNGLUSEPROGRAMSTAGESPROC glext_glUseProgramStages = NULL;
+PFNGLVALIDATEPROGRAMPIPELINEPROC glext_glValidateProgramPipeline = NULL;
+PFNGLGETPROGRAMPIPELINEIVPROC glext_glGetProgramPipelineiv = NULL;
+PFNGLGETPROGRAMPIPELINEINFOLOGPROC glext_glGetProgramPipelineInfoLog = NULL;
+PFNGLPROGRAMUNIFORM1IPROC glext_glProgramUniform1i = NULL;
+PFNGLPROGRAMUNIFORM1FPROC glext_glProgramUniform1f = NULL;
+PFNGLSHADERBINARYPROC glext_glShaderBinary = NULL;
+PFNGLSPECIALIZESHADERPROC glext_glSpecializeShader = NULL;
+PFNGLBUFFERSTORAGEPROC glext_glBufferStorage = NULL;
+PFNGLMULTIDRAWELEMENTSINDIRECTPROC glext_glMultiDrawElementsIndirect = NULL;
+
+GLExtensions glExtensions;
+
+bool isGLVersionAtLeast(int major, int minor)
+{
+    return GLVersion.major > major || (GLVersion.major == major && GLVersion.minor >= minor);
+}
+
+bool hasGLExtension(const char* name)
+{
+    int count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (int i = 0; i < count; ++i)
+    {
+        const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+        if (extension != NULL && strcmp(extension, name) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void loadGLExtensions(GLADloadproc load)
+{
+    glExtensions = GLExtensions();
+
+    if (isGLVersionAtLeast(4, 1) || hasGLExtension("GL_ARB_get_program_binary"))
+    {
+        glext_glGetProgramBinary = (PFNGLGETPROGRAMBINARYPROC)load("glGetProgramBinary");
+        glext_glProgramBinary = (PFNGLPROGRAMBINARYPROC)load("glProgramBinary");
+        glext_glProgramParameteri = (PFNGLPROGRAMPARAMETERIPROC)load("glProgramParameteri");
+
+        // 驱动可能支持扩展但一种二进制格式都不提供，这时缓存没有意义
+        int formatCount = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+        glExtensions.programBinary = glext_glGetProgramBinary != NULL && glext_glProgramBinary != NULL
+            && glext_glProgramParameteri != NULL && formatCount > 0;
+    }
+
+    // 两个扩展的枚举值相同，只是函数名后缀不同
+    if (hasGLExtension("GL_KHR_parallel_shader_compile"))
+    {
+        glext_glMaxShaderCompilerThreadsKHR = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)load("glMaxShaderCompilerThreadsKHR");
+    }
+    else if (hasGLExtension("GL_ARB_parallel_shader_compile"))
+    {
+        glext_glMaxShaderCompilerThreadsKHR = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)load("glMaxShaderCompilerThreadsARB");
+    }
+    glExtensions.parallelShaderCompile = glext_glMaxShaderCompilerThreadsKHR != NULL;
+
+    if (isGLVersionAtLeast(4, 3) || hasGLExtension("GL_ARB_vertex_attrib_binding"))
+    {
+        glext_glBindVertexBuffer = (PFNGLBINDVERTEXBUFFERPROC)load("glBindVertexBuffer");
+        glext_glVertexAttribFormat = (PFNGLVERTEXATTRIBFORMATPROC)load("glVertexAttribFormat");
+        glext_glVertexAttribIFormat = (PFNGLVERTEXATTRIBIFORMATPROC)load("glVertexAttribIFormat");
+        glext_glVertexAttribBinding = (PFNGLVERTEXATTRIBBINDINGPROC)load("glVertexAttribBinding");
+        glext_glVertexBindingDivisor = (PFNGLVERTEXBINDINGDIVISORPROC)load("glVertexBindingDivisor");
+        glExtensions.vertexAttribBinding = glext_glBindVertexBuffer != NULL && glext_glVertexAttribFormat != NULL
+            && glext_glVertexAttribIFormat != NULL && glext_glVertexAttribBinding != NULL && glext_glVertexBindingDivisor != NULL;
+    }
+
+    if (isGLVersionAtLeast(4, 1) || hasGLExtension("GL_ARB_separate_shader_objects"))
+    {
+        // glProgramParameteri 同时属于 ARB_get_program_binary，这里可能已经加载过
+        if (glext_glProgramParameteri == NULL)
+        {
+            glext_glProgramParameteri = (PFNGLPROGRAMPARAMETERIPROC)load("glProgramParameteri");
+        }
+        glext_glGenProgramPipelines = (PFNGLGENPROGRAMPIPELINESPROC)load("glGenProgramPipelines");
+        glext_glDeleteProgramPipelines = (PFNGLDELETEPROGRAMPIPELINESPROC)load("glDeleteProgramPipelines");
+        glext_glBindProgramPipeline = (PFNGLBINDPROGRAMPIPELINEPROC)load("glBindProgramPipeline");
+        glext_glUseProgramStages = (PFNGLUSEPROGRAMSTAGESPROC)load("glUseProgramStages");
+        glext_glValidateProgramPipeline = (PFNGLVALIDATEPROGRAMPIPELINEPROC)load("glValidateProgramPipeline");
+        glext_glGetProgramPipelineiv = (PFNGLGETPROGRAMPIPELINEIVPROC)load("glGetProgramPipelineiv");
+        glext_glGetProgramPipelineInfoLog = (PFNGLGETPROGRAMPIPELINEINFOLOGPROC)load("glGetProgramPipelineInfoLog");
+        glext_glProgramUniform1i = (PFNGLPROGRAMUNIFORM1IPROC)load("glProgramUniform1i");
+        glext_glProgramUniform1f = (PFNGLPROGRAMUNIFORM1FPROC)load("glProgramUniform1f");
+        glExtensions.separateShaderObjects = glext_glProgramParameteri != NULL && glext_glGenProgramPipelines != NULL
+            && glext_glDeleteProgramPipelines != NULL && glext_glBindProgramPipeline != NULL && glext_glUseProgramStages != NULL
+            && glext_glValidateProgramPipeline != NULL && glext_glGetProgramPipelineiv != NULL
+            && glext_glGetProgramPipelineInfoLog != NULL && glext_glProgramUniform1i != NULL && glext_glProgramUniform1f != NULL;
+    }
+
+    if (isGLVersionAtLeast(4, 6))
+    {
+        glext_glSpecializeShader = (PFNGLSPECIALIZESHADERPROC)load("glSpecializeShader");
+    }
+    else if (hasGLExtension("GL_ARB_gl_spirv"))
+    {
+        glext_glSpecializeShader = (PFNGLSPECIALIZESHADERPROC)load("glSpecializeShaderARB");
+    }
+    if (glext_glSpecializeShader != NULL)
+    {
+        glext_glShaderBinary = (PFNGLSHADERBINARYPROC)load("glShaderBinary");
+        glExtensions.spirv = glext_glShaderBinary != NULL;
+    }
+
+    if (isGLVersionAtLeast(4, 4) || hasGLExtension("GL_ARB_buffer_storage"))
+    {
+        glext_glBufferStorage = (PFNGLBUFFERSTORAGEPROC)load("glBufferStorage");
+        glExtensions.bufferStorage = glext_glBufferStorage != NULL;
+    }
+
+    // 扩展需要与 ARB_base_instance 一起使用，每个命令的 baseInstance 才会生效
+    if (isGLVersionAtLeast(4, 3)
+        || (hasGLExtension("GL_ARB_multi_draw_indirect") && hasGLExtension("GL_ARB_draw_indirect") && hasGLExtension("GL_ARB_base_instance")))
+    {
+        glext_glMultiDrawElementsIndirect = (PFNGLMULTIDRAWELEMENTSINDIRECTPROC)load("glMultiDrawElementsIndirect");
+        glExtensions.multiDrawIndirect = glext_glMultiDrawElementsIndirect != NULL;
+    }
+}
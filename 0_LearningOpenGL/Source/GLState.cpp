@@ -0,0 +1,276 @@
+#include "GLState.h"
+#include "GLExtensions.h"
+#include "VertexArrayCache.h"
+#include <iostream>
+
+GLState& GLState::instance()
+{
+    static GLState state;
+    return state;
+}
+
+GLState::GLState()
+{
+    invalidate();
+}
+
+void GLState::useProgram(unsigned int program)
+{
+    if (filter(this->program == program))
+    {
+        return;
+    }
+    this->program = program;
+    glUseProgram(program);
+}
+
+void GLState::bindProgramPipeline(unsigned int pipeline)
+{
+    useProgram(0);
+    if (filter(programPipeline == pipeline))
+    {
+        return;
+    }
+    programPipeline = pipeline;
+    glBindProgramPipeline(pipeline);
+}
+
+void GLState::bindVertexArray(unsigned int vertexArray)
+{
+    if (filter(this->vertexArray == vertexArray))
+    {
+        return;
+    }
+    this->vertexArray = vertexArray;
+    glBindVertexArray(vertexArray);
+    // GL_ELEMENT_ARRAY_BUFFER 的绑定属于 VAO 的状态，切换 VAO 后不再可知
+    buffers[ElementArrayBuffer] = kUnknown;
+}
+
+void GLState::bindBuffer(GLenum target, unsigned int buffer)
+{
+    int index = getBufferTarget(target);
+    if (index < 0)
+    {
+        ++issued;
+        glBindBuffer(target, buffer);
+        return;
+    }
+    if (filter(buffers[index] == buffer))
+    {
+        return;
+    }
+    buffers[index] = buffer;
+    glBindBuffer(target, buffer);
+}
+
+void GLState::bindBufferRange(GLenum target, unsigned int index, unsigned int buffer, GLintptr offset, GLsizeiptr size)
+{
+    if (target != GL_UNIFORM_BUFFER || index >= (unsigned int)kMaxUniformBufferBindings)
+    {
+        ++issued;
+        glBindBufferRange(target, index, buffer, offset, size);
+        return;
+    }
+    BufferRange& range = uniformRanges[index];
+    if (filter(range.buffer == buffer && range.offset == offset && range.size == size))
+    {
+        return;
+    }
+    range = BufferRange{ buffer, offset, size };
+    glBindBufferRange(target, index, buffer, offset, size);
+    // glBindBufferRange 同时会改变通用的 GL_UNIFORM_BUFFER 绑定
+    buffers[UniformBuffer] = buffer;
+}
+
+void GLState::setEnabled(GLenum capability, bool enabled)
+{
+    int index = getCapability(capability);
+    if (index >= 0)
+    {
+        if (filter(capabilities[index] == (enabled ? 1 : 0)))
+        {
+            return;
+        }
+        capabilities[index] = enabled ? 1 : 0;
+    }
+    else
+    {
+        ++issued;
+    }
+    if (enabled)
+    {
+        glEnable(capability);
+    }
+    else
+    {
+        glDisable(capability);
+    }
+}
+
+void GLState::blendFunc(GLenum sourceFactor, GLenum destinationFactor)
+{
+    if (filter(blend[0] == sourceFactor && blend[1] == destinationFactor))
+    {
+        return;
+    }
+    blend[0] = sourceFactor;
+    blend[1] = destinationFactor;
+    glBlendFunc(sourceFactor, destinationFactor);
+}
+
+void GLState::depthFunc(GLenum func)
+{
+    if (filter(depth == func))
+    {
+        return;
+    }
+    depth = func;
+    glDepthFunc(func);
+}
+
+void GLState::cullFace(GLenum mode)
+{
+    if (filter(cull == mode))
+    {
+        return;
+    }
+    cull = mode;
+    glCullFace(mode);
+}
+
+void GLState::viewport(int x, int y, int width, int height)
+{
+    if (filter(viewportRect[0] == x && viewportRect[1] == y && viewportRect[2] == width && viewportRect[3] == height))
+    {
+        return;
+    }
+    viewportRect[0] = x;
+    viewportRect[1] = y;
+    viewportRect[2] = width;
+    viewportRect[3] = height;
+    glViewport(x, y, width, height);
+}
+
+void GLState::deleteProgram(unsigned int program)
+{
+    if (this->program == program)
+    {
+        this->program = kUnknown;
+    }
+    glDeleteProgram(program);
+}
+
+void GLState::deleteProgramPipeline(unsigned int pipeline)
+{
+    // 删除当前绑定的 pipeline 后绑定点回到 0
+    if (programPipeline == pipeline)
+    {
+        programPipeline = 0;
+    }
+    glDeleteProgramPipelines(1, &pipeline);
+}
+
+void GLState::deleteVertexArray(unsigned int vertexArray)
+{
+    // 删除当前绑定的 VAO 后绑定点回到 0
+    if (this->vertexArray == vertexArray)
+    {
+        this->vertexArray = 0;
+        buffers[ElementArrayBuffer] = kUnknown;
+    }
+    glDeleteVertexArrays(1, &vertexArray);
+}
+
+void GLState::deleteBuffer(unsigned int buffer)
+{
+    for (unsigned int& bound : buffers)
+    {
+        if (bound == buffer)
+        {
+            bound = 0;
+        }
+    }
+    for (BufferRange& range : uniformRanges)
+    {
+        if (range.buffer == buffer)
+        {
+            range = BufferRange{ 0, 0, 0 };
+        }
+    }
+    // VAO 中记录的缓冲名字同样失效
+    VertexArrayCache::instance().invalidateBuffer(buffer);
+    glDeleteBuffers(1, &buffer);
+}
+
+void GLState::invalidate()
+{
+    program = kUnknown;
+    programPipeline = kUnknown;
+    vertexArray = kUnknown;
+    for (unsigned int& buffer : buffers)
+    {
+        buffer = kUnknown;
+    }
+    for (BufferRange& range : uniformRanges)
+    {
+        range = BufferRange{ kUnknown, 0, 0 };
+    }
+    for (int& capability : capabilities)
+    {
+        capability = -1;
+    }
+    blend[0] = blend[1] = kUnknown;
+    depth = kUnknown;
+    cull = kUnknown;
+    viewportRect[0] = viewportRect[1] = viewportRect[2] = viewportRect[3] = -1;
+}
+
+void GLState::resetCounters()
+{
+    issued = 0;
+    skipped = 0;
+}
+
+void GLState::printStats() const
+{
+    std::cout << "GL::STATE issued: " << issued << " skipped: " << skipped << std::endl;
+}
+
+bool GLState::filter(bool redundant)
+{
+    if (redundant)
+    {
+        ++skipped;
+    }
+    else
+    {
+        ++issued;
+    }
+    return redundant;
+}
+
+int GLState::getBufferTarget(GLenum target)
+{
+    switch (target)
+    {
+    case GL_ARRAY_BUFFER: return ArrayBuffer;
+    case GL_ELEMENT_ARRAY_BUFFER: return ElementArrayBuffer;
+    case GL_UNIFORM_BUFFER: return UniformBuffer;
+    case GL_COPY_READ_BUFFER: return CopyReadBuffer;
+    case GL_COPY_WRITE_BUFFER: return CopyWriteBuffer;
+    case GL_DRAW_INDIRECT_BUFFER: return DrawIndirectBuffer;
+    default: return -1;
+    }
+}
+
+int GLState::getCapability(GLenum capability)
+{
+    switch (capability)
+    {
+    case GL_BLEND: return Blend;
+    case GL_DEPTH_TEST: return DepthTest;
+    case GL_CULL_FACE: return CullFace;
+    default: return -1;
+    }
+}
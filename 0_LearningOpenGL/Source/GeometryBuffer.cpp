@@ -0,0 +1,220 @@
+#include "GeometryBuffer.h"
+#include "GLState.h"
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+namespace
+{
+    // 新建池的默认大小，单个 mesh 更大时按 mesh 的大小创建
+    const unsigned int kVertexPoolBytes = 16 * 1024 * 1024;
+    const unsigned int kIndexPoolBytes = 8 * 1024 * 1024;
+    const unsigned int kIndexUnit = 4;
+}
+
+GeometryBuffer& GeometryBuffer::instance()
+{
+    static GeometryBuffer geometryBuffer;
+    return geometryBuffer;
+}
+
+unsigned int GeometryBuffer::allocate(unsigned int stride, unsigned int size, OffsetAllocation& allocation)
+{
+    for (unsigned int i = 0; i < pools.size(); ++i)
+    {
+        if (pools[i].stride != stride)
+        {
+            continue;
+        }
+        allocation = pools[i].allocator.allocate(size);
+        if (allocation.isValid())
+        {
+            return i;
+        }
+    }
+
+    unsigned int unitBytes = stride > 0 ? stride : kIndexUnit;
+    unsigned int capacity = std::max((stride > 0 ? kVertexPoolBytes : kIndexPoolBytes) / unitBytes, size);
+    Pool pool;
+    pool.stride = stride;
+    pool.allocator.reset(capacity);
+    glGenBuffers(1, &pool.buffer);
+    // 借用 GL_COPY_WRITE_BUFFER 上传，不影响 VAO 中的索引缓冲绑定
+    GLState::instance().bindBuffer(GL_COPY_WRITE_BUFFER, pool.buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)capacity * unitBytes, NULL, GL_STATIC_DRAW);
+    allocation = pool.allocator.allocate(size);
+    pools.push_back(pool);
+    return (unsigned int)pools.size() - 1;
+}
+
+void GeometryBuffer::updateRange(Mesh& mesh)
+{
+    mesh.range.vertexBuffer = pools[mesh.vertexPool].buffer;
+    mesh.range.indexBuffer = pools[mesh.indexPool].buffer;
+    mesh.range.baseVertex = mesh.vertexAllocation.offset;
+    mesh.range.firstIndex = (unsigned int)(mesh.indexAllocation.offset * kIndexUnit / mesh.range.getIndexSize());
+}
+
+MeshHandle GeometryBuffer::upload(const void* vertices, unsigned int vertexCount, unsigned int stride,
+    const void* indices, unsigned int indexCount, GLenum indexType)
+{
+    if (vertexCount == 0 || indexCount == 0 || stride == 0
+        || (indexType != GL_UNSIGNED_SHORT && indexType != GL_UNSIGNED_INT))
+    {
+        std::cout << "ERROR::GEOMETRY::INVALID_MESH" << std::endl;
+        return kInvalidMesh;
+    }
+    if (freeMeshes.empty() && meshes.size() >= kMaxMeshes)
+    {
+        std::cout << "ERROR::GEOMETRY::TOO_MANY_MESHES" << std::endl;
+        return kInvalidMesh;
+    }
+
+    Mesh mesh;
+    mesh.live = true;
+    mesh.generation = 0;
+    mesh.range.vertexCount = vertexCount;
+    mesh.range.indexCount = indexCount;
+    mesh.range.indexType = indexType;
+    unsigned int indexBytes = (unsigned int)(indexCount * mesh.range.getIndexSize());
+    mesh.vertexPool = allocate(stride, vertexCount, mesh.vertexAllocation);
+    mesh.indexPool = allocate(0, (indexBytes + kIndexUnit - 1) / kIndexUnit, mesh.indexAllocation);
+    updateRange(mesh);
+
+    GLState& glState = GLState::instance();
+    glState.bindBuffer(GL_COPY_WRITE_BUFFER, mesh.range.vertexBuffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)mesh.vertexAllocation.offset * stride, (GLsizeiptr)vertexCount * stride, vertices);
+    glState.bindBuffer(GL_COPY_WRITE_BUFFER, mesh.range.indexBuffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)mesh.indexAllocation.offset * kIndexUnit, indexBytes, indices);
+
+    unsigned int index;
+    if (!freeMeshes.empty())
+    {
+        // 复用槽位时沿用 free 中递增过的 generation
+        index = freeMeshes.back();
+        freeMeshes.pop_back();
+        mesh.generation = meshes[index].generation;
+        meshes[index] = mesh;
+    }
+    else
+    {
+        index = (unsigned int)meshes.size();
+        meshes.push_back(mesh);
+    }
+    return index | mesh.generation << kIndexBits;
+}
+
+void GeometryBuffer::free(MeshHandle mesh)
+{
+    if (!isValid(mesh))
+    {
+        return;
+    }
+    unsigned int index = mesh & kIndexMask;
+    Mesh& entry = meshes[index];
+    pools[entry.vertexPool].allocator.free(entry.vertexAllocation);
+    pools[entry.indexPool].allocator.free(entry.indexAllocation);
+    entry.live = false;
+    entry.generation = (entry.generation + 1) & kGenerationMask;
+    freeMeshes.push_back(index);
+}
+
+void GeometryBuffer::draw(MeshHandle mesh) const
+{
+    drawRange(mesh, 0, meshes[mesh & kIndexMask].range.indexCount);
+}
+
+void GeometryBuffer::drawRange(MeshHandle mesh, unsigned int firstIndex, unsigned int indexCount) const
+{
+    const GeometryRange& range = meshes[mesh & kIndexMask].range;
+    glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)indexCount, range.indexType,
+        (void*)((range.firstIndex + firstIndex) * range.getIndexSize()), (GLint)range.baseVertex);
+}
+
+unsigned int GeometryBuffer::defragment()
+{
+    GLState& glState = GLState::instance();
+    unsigned int moved = 0;
+    for (unsigned int poolIndex = 0; poolIndex < pools.size(); ++poolIndex)
+    {
+        Pool& pool = pools[poolIndex];
+        OffsetAllocator& allocator = pool.allocator;
+        // 空闲空间都连在一起时没有碎片
+        if (allocator.getLargestFreeBlock() == allocator.getCapacity() - allocator.getUsed())
+        {
+            continue;
+        }
+
+        // 按原来的偏移顺序搬移，保持 mesh 之间的相对顺序
+        bool isIndexPool = pool.stride == 0;
+        std::vector<unsigned int> residents;
+        for (unsigned int index = 0; index < meshes.size(); ++index)
+        {
+            const Mesh& mesh = meshes[index];
+            if (mesh.live && (isIndexPool ? mesh.indexPool : mesh.vertexPool) == poolIndex)
+            {
+                residents.push_back(index);
+            }
+        }
+        std::sort(residents.begin(), residents.end(), [&](unsigned int a, unsigned int b)
+        {
+            return isIndexPool ? meshes[a].indexAllocation.offset < meshes[b].indexAllocation.offset
+                : meshes[a].vertexAllocation.offset < meshes[b].vertexAllocation.offset;
+        });
+
+        unsigned int unitBytes = isIndexPool ? kIndexUnit : pool.stride;
+        unsigned int buffer;
+        glGenBuffers(1, &buffer);
+        glState.bindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)allocator.getCapacity() * unitBytes, NULL, GL_STATIC_DRAW);
+        glState.bindBuffer(GL_COPY_READ_BUFFER, pool.buffer);
+
+        // 从空的分配器依次分配，得到的偏移是连续的
+        allocator.reset(allocator.getCapacity());
+        for (unsigned int index : residents)
+        {
+            Mesh& mesh = meshes[index];
+            OffsetAllocation& allocation = isIndexPool ? mesh.indexAllocation : mesh.vertexAllocation;
+            OffsetAllocation compacted = allocator.allocate(allocation.size);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, (GLintptr)allocation.offset * unitBytes,
+                (GLintptr)compacted.offset * unitBytes, (GLsizeiptr)allocation.size * unitBytes);
+            allocation = compacted;
+        }
+        glState.deleteBuffer(pool.buffer);
+        pool.buffer = buffer;
+
+        for (unsigned int index : residents)
+        {
+            updateRange(meshes[index]);
+        }
+        moved += (unsigned int)residents.size();
+    }
+    return moved;
+}
+
+void GeometryBuffer::printStats() const
+{
+    std::cout << "GEOMETRY::STATS meshes: " << meshes.size() - freeMeshes.size() << " pools: " << pools.size() << std::endl;
+    for (const Pool& pool : pools)
+    {
+        unsigned int unitBytes = pool.stride > 0 ? pool.stride : kIndexUnit;
+        const OffsetAllocator& allocator = pool.allocator;
+        std::cout << "    " << (pool.stride > 0 ? "vertex stride " + std::to_string(pool.stride) : std::string("index"))
+            << " used: " << (double)allocator.getUsed() * unitBytes / 1024.0
+            << " / " << (double)allocator.getCapacity() * unitBytes / 1024.0 << " KB"
+            << " free blocks: " << allocator.getFreeBlockCount()
+            << " largest: " << (double)allocator.getLargestFreeBlock() * unitBytes / 1024.0 << " KB" << std::endl;
+    }
+}
+
+void GeometryBuffer::release()
+{
+    GLState& glState = GLState::instance();
+    for (const Pool& pool : pools)
+    {
+        glState.deleteBuffer(pool.buffer);
+    }
+    pools.clear();
+    meshes.clear();
+    freeMeshes.clear();
+}
@@ -0,0 +1,122 @@
+#include "InstanceBatcher.h"
+#include "StringHash.h"
+#include "VertexArrayCache.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+InstanceBatcher::InstanceBatcher(StreamBuffer& stream)
+    : stream(stream)
+{
+}
+
+size_t InstanceBatcher::BatchKeyHash::operator()(const BatchKey& key) const
+{
+    // 只用于分桶，相等与否由 BatchKey::operator== 判断
+    const void* pointers[] = { key.meshLayout, key.shader, key.instanceLayout };
+    return (size_t)hashBytes64(pointers, sizeof(pointers), key.mesh);
+}
+
+void InstanceBatcher::add(MeshHandle mesh, const VertexLayout& meshLayout, Shader& shader, const VertexLayout& instanceLayout, const void* instance)
+{
+    BatchKey key = { mesh, &meshLayout, &shader, &instanceLayout };
+    auto it = batchIndices.find(key);
+    if (it == batchIndices.end())
+    {
+        it = batchIndices.emplace(key, batches.size()).first;
+        Batch batch = { mesh, &meshLayout, &shader, &instanceLayout, 0, {}, {} };
+        batches.push_back(batch);
+    }
+
+    Batch& batch = batches[it->second];
+    size_t offset = batch.instances.size();
+    batch.instances.resize(offset + instanceLayout.stride);
+    memcpy(batch.instances.data() + offset, instance, instanceLayout.stride);
+    ++batch.instanceCount;
+}
+
+void InstanceBatcher::flush()
+{
+    GeometryBuffer& geometry = GeometryBuffer::instance();
+    drawOrder.clear();
+    // 先把所有批次的实例数据写入流式缓冲，一次 flush 后再绘制；GL 3.3 的映射在绘制前必须解除
+    for (size_t i = 0; i < batches.size(); ++i)
+    {
+        Batch& batch = batches[i];
+        if (batch.instanceCount == 0)
+        {
+            continue;
+        }
+        if (!geometry.isValid(batch.mesh))
+        {
+            batch.instances.clear();
+            batch.instanceCount = 0;
+            continue;
+        }
+        batch.range = stream.allocateVertices((unsigned int)batch.instances.size(), batch.instanceLayout->stride);
+        if (batch.range.data == nullptr)
+        {
+            batch.instances.clear();
+            batch.instanceCount = 0;
+            continue;
+        }
+        memcpy(batch.range.data, batch.instances.data(), batch.instances.size());
+        drawOrder.push_back(i);
+    }
+    stream.flush();
+
+    // 相同 shader 的批次相邻，减少 program 切换
+    std::sort(drawOrder.begin(), drawOrder.end(), [this](size_t a, size_t b)
+    {
+        return batches[a].shader->shaderProgram < batches[b].shader->shaderProgram;
+    });
+
+    VertexArrayCache& vertexArrays = VertexArrayCache::instance();
+    for (size_t index : drawOrder)
+    {
+        Batch& batch = batches[index];
+        GeometryRange range = geometry.get(batch.mesh);
+        batch.shader->use();
+        vertexArrays.bind(*batch.meshLayout, *batch.instanceLayout, *batch.shader,
+            range.vertexBuffer, stream.getBuffer(), batch.range.offset, range.indexBuffer);
+        glDrawElementsInstancedBaseVertex(GL_TRIANGLES, (GLsizei)range.indexCount, range.indexType,
+            (void*)(range.firstIndex * range.getIndexSize()), (GLsizei)batch.instanceCount, (GLint)range.baseVertex);
+
+        instances += batch.instanceCount;
+        ++draws;
+        batch.instances.clear();
+        batch.instanceCount = 0;
+    }
+    ++frames;
+
+    // 只保留本帧画过的批次，连续使用的批次仍然复用内存；
+    // 本帧没有实例或 mesh 已经释放的批次删除，创建和释放 mesh 时批次数不会一直增长
+    if (drawOrder.size() == batches.size())
+    {
+        return;
+    }
+    std::sort(drawOrder.begin(), drawOrder.end());
+    batchIndices.clear();
+    size_t write = 0;
+    for (size_t index : drawOrder)
+    {
+        if (write != index)
+        {
+            batches[write] = std::move(batches[index]);
+        }
+        const Batch& batch = batches[write];
+        BatchKey key = { batch.mesh, batch.meshLayout, batch.shader, batch.instanceLayout };
+        batchIndices.emplace(key, write);
+        ++write;
+    }
+    batches.resize(write);
+}
+
+void InstanceBatcher::printStats() const
+{
+    unsigned int frameCount = std::max(frames, 1u);
+    std::cout << "INSTANCE::STATS frames: " << frames
+        << " instances/frame: " << instances / frameCount
+        << " draws/frame: " << draws / frameCount
+        << " batches: " << batches.size() << std::endl;
+}
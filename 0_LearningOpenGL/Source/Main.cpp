@@ -1,11 +1,66 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <cmath>
+#include <cstring>
 #include <iostream>
+#include <utility>
+#include <vector>
 #include "Shader.h"
+#include "ShaderVariants.h"
+#include "Uniform.h"
+#include "UniformBuffer.h"
+#include "GLExtensions.h"
+#include "GLState.h"
+#include "GeometryBuffer.h"
+#include "InstanceBatcher.h"
+#include "MultiDrawBatcher.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "Meshlets.h"
+#include "ShaderCache.h"
+#include "ShaderPipeline.h"
+#include "ShaderTelemetry.h"
+#include "VertexArrayCache.h"
+#include "VertexBenchmark.h"
+#include "VertexFormat.h"
+#include "EmbeddedShaders.h"
+#include "MappedFile.h"
+
+// Release 从嵌入的数据加载 shader，启动时不访问文件系统，也不依赖工作目录；
+// Release 的预生成步骤同时嵌入离线优化的源码和 SPIR-V，嵌入路径下两者仍然可用；
+// Debug 从磁盘加载，修改 shader 后可以热重载
+#ifdef NDEBUG
+#define SHADER_PATH(path) EMBEDDED_PATH_PREFIX path
+#else
+#define SHADER_PATH(path) path
+#endif
+
+// 顶点格式：{x, y, z, r, g, b}，属性按名字对应到 shader 的 aPos/aColor，location 由反射得到
+// stride 和每个属性的 offset 由 VertexFormat 在编译期计算，不再手写 6 * sizeof(float)
+using PositionColorFormat = VertexFormat<Position3f, Color3f>;
+
+struct PositionColorVertex
+{
+    float position[3];
+    float color[3];
+};
+static_assert(PositionColorFormat::matches<PositionColorVertex>(), "PositionColorVertex does not match PositionColorFormat");
+static_assert(PositionColorFormat::offset<1>() == offsetof(PositionColorVertex, color), "color offset mismatch");
+
+// 实例格式：每个 quad 拷贝的 2D 变换、颜色和 ratio，divisor 为 1
+using QuadInstanceFormat = VertexFormat<InstanceTransform4f, InstanceColor3f, InstanceRatio1f>;
+
+struct QuadInstance
+{
+    float transform[4];
+    float color[3];
+    float ratio;
+};
+static_assert(QuadInstanceFormat::matches<QuadInstance>(), "QuadInstance does not match QuadInstanceFormat");
 
 static void framebuffer_size_callback(GLFWwindow* window, int width, int height)
 {
-    glViewport(0, 0, width, height);
+    GLState::instance().viewport(0, 0, width, height);
 }
 
 static void processInput(GLFWwindow* window)
@@ -41,9 +96,11 @@ static GLFWwindow* createWindow()
         std::cout << "Failed to initialize GLAD" << std::endl;
         return nullptr;
     }
+    // 加载 GL 3.3 之外的扩展函数（program 二进制等）
+    loadGLExtensions((GLADloadproc)glfwGetProcAddress);
 
     // 设定 viewport 的 size
-    glViewport(0, 0, 800, 600);
+    GLState::instance().viewport(0, 0, 800, 600);
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
 
     return window;
@@ -52,17 +109,46 @@ static GLFWwindow* createWindow()
 int main(int argc, char* arv[])
 {
     GLFWwindow* window = createWindow();
-    Shader shader("Shader/VertexShader.vert", "Shader/FragmentShader.frag");
+    // --vertex-benchmark：对比 float 与量化顶点格式的显存和帧时间后退出
+    if (argc > 1 && strcmp(arv[1], "--vertex-benchmark") == 0)
+    {
+        // 两个顶点格式共用同一个片段阶段，支持 separate shader objects 时 MeshShader.frag 只编译一次
+        ShaderPipelineCache& pipelines = ShaderPipelineCache::instance();
+        ShaderPipeline& meshPipeline = pipelines.get(SHADER_PATH("Shader/MeshShader.vert"), SHADER_PATH("Shader/MeshShader.frag"));
+        ShaderPipeline& quantizedMeshPipeline = pipelines.get(SHADER_PATH("Shader/QuantizedMeshShader.vert"), SHADER_PATH("Shader/MeshShader.frag"));
+        runVertexBenchmark(window, meshPipeline, quantizedMeshPipeline);
+        VertexArrayCache::instance().release();
+        pipelines.printStats();
+        pipelines.release();
+        glfwTerminate();
+        return 0;
+    }
+    // fallback 很小，同步编译；正式的 shader 通过 batch 异步编译，不阻塞启动和渲染
+    // fallback 始终使用嵌入的源码，工作目录不对时也能画出东西
+    Shader fallbackShader(EmbeddedShaders::FallbackShader_vert, EmbeddedShaders::FallbackShader_frag);
+    // quad 的多个拷贝用一次实例化绘制画出，每个实例的参数来自实例缓冲而不是 uniform
+    Shader instancedShader(SHADER_PATH("Shader/InstancedShader.vert"), SHADER_PATH("Shader/InstancedShader.frag"));
+    // 每个 feature 对应 mask 中的一位，变体在第一次 get 时才编译
+    const uint32_t kVertexColor = 1u << 0;
+    ShaderVariants shaderVariants(SHADER_PATH("Shader/VertexShader.vert"), SHADER_PATH("Shader/FragmentShader.frag"), { "USE_VERTEX_COLOR" });
+    // 修改 shader 文件后无需重启，update 中重新编译并替换
+    shaderVariants.enableHotReload();
+    // 上次运行用到的变体在启动时一次性异步编译
+    shaderVariants.prewarm("ShaderUsage.log");
+    // 命中缓存时跳过了驱动的编译和 link，可以对比启动耗时
+    ShaderCache::instance().printStats();
+    // 文件加载耗时与拷贝量（源码只拷贝一次，SPIR-V 和 program 二进制不拷贝）
+    MappedFile::printStats();
 
     // 定义三角形在正则坐标下的坐标值
-    float vertices[] = {
-        0.5f, 0.5f, 0.0f, 1.0f, 0.0f, 0.0f, // 右上角
-        0.5f, -0.5f, 0.0f, 0.0f, 1.0f, 0.0f, // 右下角
-        -0.5f, -0.5f, 0.0f, 0.0f, 0.0f, 1.0f, // 左下角
-        -0.5f, 0.5f, 0.0f, 1.0f, 1.0f, 1.0f // 左上角
+    std::vector<PositionColorVertex> vertices = {
+        { { 0.5f, 0.5f, 0.0f }, { 1.0f, 0.0f, 0.0f } }, // 右上角
+        { { 0.5f, -0.5f, 0.0f }, { 0.0f, 1.0f, 0.0f } }, // 右下角
+        { { -0.5f, -0.5f, 0.0f }, { 0.0f, 0.0f, 1.0f } }, // 左下角
+        { { -0.5f, 0.5f, 0.0f }, { 1.0f, 1.0f, 1.0f } } // 左上角
     };
 
-    unsigned int indices[] = {
+    std::vector<unsigned int> indices = {
         // 注意索引从0开始!
         // 此例的索引(0,1,2,3)就是顶点数组vertices的下标，
         // 这样可以由下标代表顶点组合成矩形
@@ -70,46 +156,69 @@ int main(int argc, char* arv[])
         0, 1, 3, // 第一个三角形
         1, 2, 3  // 第二个三角形
     };
+    // 按顶点缓存、overdraw、顶点拉取顺序重排，顶点数小于 65536 时打包成 16 位索引
+    optimizeMesh(vertices, indices);
+    // 生成 LOD 链，所有 LOD 共用顶点缓冲，索引依次存放在同一个索引缓冲中；颜色作为属性参与误差计算
+    LodSettings lodSettings;
+    lodSettings.attributeOffset = offsetof(PositionColorVertex, color);
+    lodSettings.attributeCount = 3;
+    LodChain lodChain = buildLodChain(vertices, indices, lodSettings);
+    IndexData indexData = packIndices(lodChain.indices, vertices.size());
+    // 每级 LOD 各自切成 meshlet，meshlet 的 indexOffset 相对于该级 LOD 的起点
+    std::vector<std::vector<Meshlet>> lodMeshlets;
+    for (const MeshLod& lod : lodChain.lods)
+    {
+        lodMeshlets.push_back(buildMeshlets(vertices, lodChain.indices.data() + lod.indexOffset, lod.indexCount));
+    }
+
+    // 所有绑定都经过状态缓存，重复的绑定不会进入驱动
+    GLState& glState = GLState::instance();
+
+    // 顶点和索引不再各自创建 VBO/EBO，而是放进共用的大 buffer：
+    // 同一格式的所有 mesh 共用一个顶点缓冲，绘制时用 baseVertex 和 firstIndex 定位，切换 mesh 不需要重新绑定
+    GeometryBuffer& geometry = GeometryBuffer::instance();
+    MeshHandle quadMesh = geometry.upload(vertices, indexData);
+    // 与 quad 同一格式的三角形，和 quad 共用顶点池与索引池
+    std::vector<PositionColorVertex> triangleVertices = {
+        { { 0.0f, 0.5f, 0.0f }, { 1.0f, 0.0f, 0.0f } },
+        { { -0.5f, -0.5f, 0.0f }, { 0.0f, 1.0f, 0.0f } },
+        { { 0.5f, -0.5f, 0.0f }, { 0.0f, 0.0f, 1.0f } }
+    };
+    MeshHandle triangleMesh = geometry.upload(triangleVertices, packIndices({ 0, 1, 2 }, triangleVertices.size()));
+    // 静态物体：quad 与三角形交替，每个物体的变换、颜色和 ratio 作为物体数据
+    std::vector<std::pair<MeshHandle, QuadInstance>> staticObjects;
+    for (int i = 0; i < 4; ++i)
+    {
+        QuadInstance object = {
+            { (i % 2 == 0 ? -0.8f : 0.8f), (i < 2 ? -0.4f : 0.4f), 0.25f, i * 0.4f },
+            { 1.0f, 1.0f - i * 0.2f, 0.5f + i * 0.1f },
+            1.0f
+        };
+        staticObjects.emplace_back(i % 2 == 0 ? quadMesh : triangleMesh, object);
+    }
 
-    // 创建 VAO
-    unsigned int VAO;
-    glGenVertexArrays(1, &VAO);
-    // 将 VAO 绑定到当前上下文
-    glBindVertexArray(VAO);
-
-    unsigned int VBO;
-    // 生成 1 个 buffer，buffer index 赋值给 VBO
-    glGenBuffers(1, &VBO);
-    // 指定 VBO 对应的 buffer 类型为 GL_ARRAY_BUFFER
-    // 将 VBO 对应的 buffer 绑定到上下文，后续的操作都是基于当前 buffer
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    // 把的顶点数据复制到 buffer 中
-    // GL_STATIC_DRAW 表示数据不会或几乎不会改变
-    // 若指定为 GL_DYNAMIC_DRAW 或 GL_STREAM_DRAW，GPU 会把数据放在能够高速写入的内存部分
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    unsigned int EBO;
-    glGenBuffers(1, &EBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-
-    // 如何解释内存中的顶点数据，以及如何将顶点数据链接到 shader 的属性上
-    // @param0：标识当前 vertex 的属性，相当于将当前 vertex 数据传到 vertex shader 中的 location = 0 指定的变量 aPos
-    // @param1：指定一个 vertex 的元素数量为 3
-    // @param2：指定 vertex 的类型为 float
-    // @param3：表明 vertex 数据不需要被标准化到 [0, 1]
-    // @param4：步长，表明每组 vertex 属性的元素个数，比如 {x, y, z, r, g, b, a} 的时候为 7
-    // @param5：偏移，表明 vertex 从哪个位置开始取，比如 {x, y, z, r, g, b, a} 如果想去颜色就设为 3
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    // 启用顶点属性
-    glEnableVertexAttribArray(0);
-
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    // VAO 不再手动创建：VertexArrayCache 根据 PositionColorFormat::layout 和 shader 反射出的顶点输入生成并缓存，
+    // 格式与 shader 不匹配时会报错，而不是静默地画错
+    VertexArrayCache& vertexArrays = VertexArrayCache::instance();
 
     // 线框模式
     // glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 
+    // 所有 uniform block 的数据每帧直接写入映射的流式缓冲，绘制时按区间绑定
+    UniformBufferRing uniformRing(64 * 1024);
+    // PerFrame block 的 std140 布局在 program 可用后通过反射得到
+    UniformBlockLayout perFrameLayout;
+    // 顶点直接是正则坐标，视锥就是 [-1, 1] 的立方体；没有开启 GL_CULL_FACE，背面也要画，不做法线锥剔除
+    const Mat4 kIdentity = { { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f } };
+    MeshletCullView cullView = makeOrthographicCullView(kIdentity, { 0.0f, 0.0f, -1.0f }, false);
+    MeshletDrawList meshletDrawList;
+    MeshletCullStats meshletStats;
+    // 实例数据每帧写入流式缓冲，按 (mesh, shader, 实例格式) 自动合批
+    StreamBuffer instanceStream(16 * 1024);
+    InstanceBatcher instanceBatcher(instanceStream);
+    // 静态物体合成一次 glMultiDrawElementsIndirect，GL 4.3 以下逐个 glDrawElementsBaseVertex
+    MultiDrawBatcher multiDrawBatcher(instanceStream);
+
     // 循环处理输入并渲染
     while (!glfwWindowShouldClose(window))
     {
@@ -118,30 +227,114 @@ int main(int argc, char* arv[])
         glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
 
+        // 收集已经编译完成的 program，编译完成之前先用 fallback 绘制，不会卡住当前帧
+        shaderVariants.update();
+        Shader& shader = shaderVariants.get(kVertexColor);
+        Shader& activeShader = shader.isReady() ? shader : fallbackShader;
+
         // 使用 program，后续每个 Shader 调用和渲染调用都会用到这个 program
-        shader.use();
+        activeShader.use();
 
         float timeValue = glfwGetTime();
         float ratio = (sin(timeValue) / 2.0f) + 0.5f;
-        // glUniform4f 之前必须先调用 glUseProgram，因为需要在当前激活的 shader program 中设置 uniform
-        shader.setFloat("ratio", ratio);
+        // fallback 不使用 uniform block，颜色通过类型化的 uniform 句柄设置，location 只解析一次
+        if (&activeShader == &fallbackShader)
+        {
+            static Uniform<Vec3> fallbackColor("fallbackColor");
+            float gray = 0.3f + 0.2f * ratio;
+            fallbackColor.set(fallbackShader, Vec3{ gray, gray, gray });
+        }
+        // 写入本帧的 PerFrame 数据，flush 时一次性上传，再绑定到 PerFrame 绑定点
+        uniformRing.beginFrame();
+        if (!perFrameLayout.isValid() && shader.isReady())
+        {
+            perFrameLayout.reflect(shader.shaderProgram, "PerFrame");
+        }
+        if (perFrameLayout.isValid())
+        {
+            UniformBufferRange perFrame = uniformRing.allocate(perFrameLayout.getSize());
+            perFrameLayout.set(perFrame.data, "ratio", ratio);
+            uniformRing.flush();
+            uniformRing.bind(UniformBlockSlot::PerFrame, perFrame);
+        }
 
-        // 绑定 VAO，在这里其实不绑定也行，因为我们只有一个 VAO
-        // 实际的项目中会有多个 VAO，就需要根据不同的逻辑绑定不同的 VAO
-        glBindVertexArray(VAO);
+        // 绑定 (顶点格式, shader) 对应的 VAO，同一格式的其他 mesh 只会切换顶点/索引缓冲
+        GeometryRange quadRange = geometry.get(quadMesh);
+        vertexArrays.bind(PositionColorFormat::layout, activeShader, quadRange.vertexBuffer, quadRange.indexBuffer);
         // @param2：表示索引 VAO 的第 0 个位置的 VBO
         // glDrawArrays(GL_TRIANGLES, 0, 3);
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+        // 按屏幕空间误差选择 LOD：顶点直接是正则坐标，一个单位对应半个视口高度
+        int framebufferWidth, framebufferHeight;
+        glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+        size_t lodLevel = selectLod(lodChain.lods, framebufferHeight * 0.5f);
+        // 只提交可见的 meshlet，相邻的合并成一段；索引类型由 packIndices 决定
+        meshletDrawList.clear();
+        cullMeshlets(lodMeshlets[lodLevel], cullView, quadRange.firstIndex + lodChain.lods[lodLevel].indexOffset,
+            meshletDrawList, &meshletStats);
+        meshletDrawList.draw(quadRange.indexType, quadRange.getIndexSize(), (int)quadRange.baseVertex);
+        ++meshletStats.frames;
+        meshletStats.drawRanges += meshletDrawList.getRangeCount();
+
+        // 四周 8 个缩小的 quad 拷贝，合成一次 glDrawElementsInstanced
+        instanceStream.beginFrame();
+        if (instancedShader.isReady())
+        {
+            for (int i = 0; i < 9; ++i)
+            {
+                if (i == 4)
+                {
+                    continue;
+                }
+                float phase = i * 0.7f;
+                QuadInstance instance = {
+                    { (i % 3 - 1) * 0.8f, (i / 3 - 1) * 0.8f, 0.3f, timeValue + phase },
+                    { 0.5f + 0.5f * (i % 3) / 2.0f, 0.5f + 0.5f * (i / 3) / 2.0f, 1.0f },
+                    (std::sin(timeValue + phase) / 2.0f) + 0.5f
+                };
+                instanceBatcher.add(quadMesh, PositionColorFormat::layout, instancedShader, QuadInstanceFormat::layout, instance);
+            }
+        }
+        instanceBatcher.flush();
+        if (instancedShader.isReady())
+        {
+            multiDrawBatcher.begin(PositionColorFormat::layout, instancedShader, QuadInstanceFormat::layout);
+            for (const auto& object : staticObjects)
+            {
+                multiDrawBatcher.add(object.first, object.second);
+            }
+            multiDrawBatcher.submit();
+        }
+        instanceStream.endFrame();
+        uniformRing.endFrame();
 
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
 
     // 释放资源
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
-    glDeleteBuffers(1, &EBO);
-    shader.release();
+    vertexArrays.release();
+    // 共用 buffer 的占用和碎片情况
+    geometry.printStats();
+    geometry.release();
+    shaderVariants.saveUsageLog("ShaderUsage.log");
+    shaderVariants.release();
+    // 持久映射/非同步映射的上传量和等待 fence 的时间
+    uniformRing.printStats();
+    uniformRing.release();
+    // 每帧的实例数和实际的绘制次数
+    instanceBatcher.printStats();
+    // MDI 或退化路径下每帧的物体数与绘制调用数
+    multiDrawBatcher.printStats();
+    instanceStream.release();
+    instancedShader.release();
+    fallbackShader.release();
+    // 被状态缓存过滤掉的调用次数
+    glState.printStats();
+    // 每帧平均提交和剔除的三角形数
+    printMeshletCullStats(meshletStats);
+    // 最慢的几个 program，完整数据写入 JSON 用于跨版本对比
+    ShaderTelemetry::instance().printSummary();
+    ShaderTelemetry::instance().writeJson("ShaderTelemetry.json");
     glfwTerminate();
 
     return 0;
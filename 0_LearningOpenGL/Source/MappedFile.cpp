@@ -0,0 +1,209 @@
+#include "MappedFile.h"
+#include "EmbeddedFiles.h"
+#include <chrono>
+#include <iostream>
+#include <utility>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::Stats MappedFile::stats;
+
+MappedFile::MappedFile(const std::string& path)
+{
+    open(path);
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other)
+{
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other)
+{
+    if (this != &other)
+    {
+        close();
+        begin = other.begin;
+        length = other.length;
+        opened = other.opened;
+        mapped = other.mapped;
+#ifdef _WIN32
+        fileHandle = other.fileHandle;
+        mappingHandle = other.mappingHandle;
+        other.fileHandle = nullptr;
+        other.mappingHandle = nullptr;
+#endif
+        other.begin = nullptr;
+        other.length = 0;
+        other.opened = false;
+        other.mapped = false;
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& path, bool reportError)
+{
+    close();
+    auto start = std::chrono::steady_clock::now();
+
+    if (isEmbeddedPath(path))
+    {
+        const EmbeddedFile* embedded = findEmbeddedFile(path);
+        if (embedded != nullptr)
+        {
+            begin = embedded->data;
+            length = embedded->size;
+            opened = true;
+        }
+    }
+    else
+    {
+        opened = map(path);
+    }
+
+    if (!opened)
+    {
+        if (reportError)
+        {
+            std::cout << "ERROR::FILE::OPEN_FAILED " << path << std::endl;
+        }
+        return false;
+    }
+    ++stats.files;
+    stats.bytesMapped += length;
+    stats.milliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+bool MappedFile::map(const std::string& path)
+{
+#ifdef _WIN32
+    // 允许其他进程同时写入/改名，编辑器保存时不会因为文件被占用而失败
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        CloseHandle(file);
+        return false;
+    }
+    // 空文件不能创建映射
+    if (fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        begin = "";
+        length = 0;
+        return true;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    const void* view = mapping != NULL ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (view == NULL)
+    {
+        if (mapping != NULL)
+        {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    begin = static_cast<const char*>(view);
+    length = (size_t)fileSize.QuadPart;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+    if (fileStat.st_size == 0)
+    {
+        ::close(fd);
+        begin = "";
+        length = 0;
+        return true;
+    }
+    void* view = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // 映射建立之后文件描述符就不再需要
+    ::close(fd);
+    if (view == MAP_FAILED)
+    {
+        return false;
+    }
+    begin = static_cast<const char*>(view);
+    length = (size_t)fileStat.st_size;
+#endif
+    mapped = true;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (mapped)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(begin);
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        mappingHandle = nullptr;
+        fileHandle = nullptr;
+#else
+        munmap(const_cast<char*>(begin), length);
+#endif
+    }
+    begin = nullptr;
+    length = 0;
+    opened = false;
+    mapped = false;
+}
+
+void MappedFile::copyTo(std::string& content, bool text) const
+{
+    if (!text)
+    {
+        content.assign(begin != nullptr ? begin : "", length);
+    }
+    else
+    {
+        // 与文本方式读取一致，拷贝的同时把 \r\n 换成 \n
+        content.clear();
+        content.reserve(length);
+        for (size_t i = 0; i < length; ++i)
+        {
+            if (begin[i] != '\r' || i + 1 >= length || begin[i + 1] != '\n')
+            {
+                content += begin[i];
+            }
+        }
+    }
+    stats.bytesCopied += length;
+}
+
+void MappedFile::printStats()
+{
+    std::cout << "FILE::LOAD files: " << stats.files << " bytes: " << stats.bytesMapped
+        << " copied: " << stats.bytesCopied << " time: " << stats.milliseconds << " ms" << std::endl;
+}
@@ -0,0 +1,415 @@
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+    // Forsyth 算法的参数，模拟 32 项的 LRU 缓存
+    const int kCacheSize = 32;
+    const float kCacheDecayPower = 1.5f;
+    const float kLastTriangleScore = 0.75f;
+    const float kValenceBoostScale = 2.0f;
+    const float kValenceBoostPower = 0.5f;
+
+    // 顶点越靠近缓存前端、剩余的三角形越少，分数越高；没有剩余三角形的顶点不再参与
+    float getVertexScore(int cachePosition, unsigned int liveTriangles)
+    {
+        if (liveTriangles == 0)
+        {
+            return -1.0f;
+        }
+        float score = 0.0f;
+        if (cachePosition >= 0)
+        {
+            // 刚刚用过的三个顶点分数固定，避免总是选择与上一个三角形共边的三角形形成长条
+            score = cachePosition < 3 ? kLastTriangleScore
+                : std::pow(1.0f - (float)(cachePosition - 3) / (kCacheSize - 3), kCacheDecayPower);
+        }
+        // 剩余三角形少的顶点优先处理，避免留下孤立的三角形
+        return score + kValenceBoostScale * std::pow((float)liveTriangles, -kValenceBoostPower);
+    }
+
+    // FIFO 缓存模拟：顶点在之后的 size 次未命中之内都还在缓存中
+    class FifoCache
+    {
+    public:
+        FifoCache(size_t vertexCount, unsigned int size)
+            : timestamps(vertexCount, 0), time(size + 1), size(size)
+        {
+        }
+        // 返回是否未命中
+        bool access(unsigned int vertex)
+        {
+            if (time - timestamps[vertex] > size)
+            {
+                timestamps[vertex] = time++;
+                return true;
+            }
+            return false;
+        }
+        void clear()
+        {
+            time += size + 1;
+        }
+    private:
+        std::vector<unsigned int> timestamps;
+        unsigned int time;
+        unsigned int size;
+    };
+
+    void readPosition(const void* positions, size_t stride, unsigned int vertex, float* position)
+    {
+        memcpy(position, static_cast<const char*>(positions) + vertex * stride, sizeof(float) * 3);
+    }
+
+    struct Cluster
+    {
+        size_t begin;
+        size_t end;
+        float sortKey;
+    };
+}
+
+VertexCacheStats analyzeVertexCache(const unsigned int* indices, size_t indexCount, size_t vertexCount, unsigned int cacheSize)
+{
+    FifoCache cache(vertexCount, cacheSize);
+    std::vector<bool> referenced(vertexCount, false);
+    size_t misses = 0;
+    size_t uniqueVertices = 0;
+    for (size_t i = 0; i < indexCount; ++i)
+    {
+        misses += cache.access(indices[i]) ? 1 : 0;
+        if (!referenced[indices[i]])
+        {
+            referenced[indices[i]] = true;
+            ++uniqueVertices;
+        }
+    }
+    VertexCacheStats stats = { 0.0f, 0.0f };
+    if (indexCount >= 3)
+    {
+        stats.acmr = (float)misses / (indexCount / 3);
+        stats.atvr = (float)misses / uniqueVertices;
+    }
+    return stats;
+}
+
+void optimizeVertexCache(unsigned int* destination, const unsigned int* indices, size_t indexCount, size_t vertexCount)
+{
+    size_t triangleCount = indexCount / 3;
+    // destination 可能与 indices 相同
+    std::vector<unsigned int> source(indices, indices + triangleCount * 3);
+
+    // 每个顶点相邻的三角形，前 liveTriangles[v] 个是还没有输出的
+    std::vector<unsigned int> liveTriangles(vertexCount, 0);
+    for (unsigned int vertex : source)
+    {
+        ++liveTriangles[vertex];
+    }
+    std::vector<unsigned int> adjacencyOffset(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v)
+    {
+        adjacencyOffset[v + 1] = adjacencyOffset[v] + liveTriangles[v];
+    }
+    std::vector<unsigned int> adjacency(source.size());
+    std::vector<unsigned int> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        adjacency[fill[source[i]]++] = (unsigned int)(i / 3);
+    }
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v)
+    {
+        vertexScore[v] = getVertexScore(-1, liveTriangles[v]);
+    }
+    std::vector<bool> emitted(triangleCount, false);
+
+    std::vector<unsigned int> cache;
+    std::vector<unsigned int> nextCache;
+    size_t cursor = 0;
+    int best = -1;
+    for (size_t output = 0; output < triangleCount; ++output)
+    {
+        // 缓存中的顶点没有剩余三角形时，取输入顺序中下一个未输出的三角形
+        if (best < 0)
+        {
+            while (emitted[cursor])
+            {
+                ++cursor;
+            }
+            best = (int)cursor;
+        }
+        unsigned int triangle = (unsigned int)best;
+        const unsigned int* corners = &source[triangle * 3];
+        memcpy(destination + output * 3, corners, sizeof(unsigned int) * 3);
+        emitted[triangle] = true;
+
+        // 从三个顶点的邻接表中去掉这个三角形
+        for (int k = 0; k < 3; ++k)
+        {
+            unsigned int vertex = corners[k];
+            unsigned int* list = &adjacency[adjacencyOffset[vertex]];
+            unsigned int& count = liveTriangles[vertex];
+            for (unsigned int j = 0; j < count; ++j)
+            {
+                if (list[j] == triangle)
+                {
+                    list[j] = list[count - 1];
+                    --count;
+                    break;
+                }
+            }
+        }
+
+        // 新三角形的顶点移到缓存前端，超出缓存大小的顶点被挤出
+        nextCache.assign(corners, corners + 3);
+        for (unsigned int vertex : cache)
+        {
+            if (vertex != corners[0] && vertex != corners[1] && vertex != corners[2])
+            {
+                nextCache.push_back(vertex);
+            }
+        }
+        for (size_t i = 0; i < nextCache.size(); ++i)
+        {
+            unsigned int vertex = nextCache[i];
+            cachePosition[vertex] = i < (size_t)kCacheSize ? (int)i : -1;
+            vertexScore[vertex] = getVertexScore(cachePosition[vertex], liveTriangles[vertex]);
+        }
+        cache.assign(nextCache.begin(), nextCache.begin() + std::min(nextCache.size(), (size_t)kCacheSize));
+
+        // 只有缓存中（以及刚被挤出）的顶点分数发生变化，重新计算它们相邻的三角形并找出最高分
+        best = -1;
+        float bestScore = -1.0f;
+        for (unsigned int vertex : nextCache)
+        {
+            const unsigned int* list = &adjacency[adjacencyOffset[vertex]];
+            for (unsigned int j = 0; j < liveTriangles[vertex]; ++j)
+            {
+                unsigned int t = list[j];
+                float score = vertexScore[source[t * 3]] + vertexScore[source[t * 3 + 1]] + vertexScore[source[t * 3 + 2]];
+                if (cachePosition[vertex] >= 0 && score > bestScore)
+                {
+                    best = (int)t;
+                    bestScore = score;
+                }
+            }
+        }
+    }
+}
+
+void optimizeOverdraw(unsigned int* destination, const unsigned int* indices, size_t indexCount,
+    const void* positions, size_t vertexCount, size_t positionStride, float threshold)
+{
+    const unsigned int kFifoSize = 16;
+    size_t triangleCount = indexCount / 3;
+    std::vector<unsigned int> source(indices, indices + triangleCount * 3);
+    if (triangleCount == 0)
+    {
+        return;
+    }
+
+    // 1. 硬边界：三个顶点都未命中的三角形处缓存相当于被清空，在这里切开不会增加未命中
+    std::vector<size_t> hardBoundaries;
+    FifoCache cache(vertexCount, kFifoSize);
+    for (size_t t = 0; t < triangleCount; ++t)
+    {
+        int misses = 0;
+        for (int k = 0; k < 3; ++k)
+        {
+            misses += cache.access(source[t * 3 + k]) ? 1 : 0;
+        }
+        if (t == 0 || misses == 3)
+        {
+            hardBoundaries.push_back(t);
+        }
+    }
+    hardBoundaries.push_back(triangleCount);
+
+    // 2. 软边界：硬边界之间的簇继续切分，子簇从空缓存开始的 ACMR 不超过整个簇的 threshold 倍时切开
+    std::vector<Cluster> clusters;
+    for (size_t h = 0; h + 1 < hardBoundaries.size(); ++h)
+    {
+        size_t begin = hardBoundaries[h];
+        size_t end = hardBoundaries[h + 1];
+        cache.clear();
+        size_t misses = 0;
+        for (size_t i = begin * 3; i < end * 3; ++i)
+        {
+            misses += cache.access(source[i]) ? 1 : 0;
+        }
+        float clusterAcmr = (float)misses / (end - begin);
+
+        cache.clear();
+        misses = 0;
+        size_t start = begin;
+        for (size_t t = begin; t < end; ++t)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                misses += cache.access(source[t * 3 + k]) ? 1 : 0;
+            }
+            float acmr = (float)misses / (t + 1 - start);
+            if (t + 1 < end && acmr <= clusterAcmr * threshold)
+            {
+                clusters.push_back({ start, t + 1, 0.0f });
+                start = t + 1;
+                misses = 0;
+                cache.clear();
+            }
+        }
+        clusters.push_back({ start, end, 0.0f });
+    }
+
+    // 3. 以面积加权的簇中心相对于整个 mesh 中心的偏移在簇法线上的投影排序：越朝外的簇越先画，更可能遮挡其他簇
+    std::vector<float> triangleCentroids(triangleCount * 3);
+    std::vector<float> triangleNormals(triangleCount * 3);
+    float meshCentroid[3] = { 0.0f, 0.0f, 0.0f };
+    float meshArea = 0.0f;
+    for (size_t t = 0; t < triangleCount; ++t)
+    {
+        float a[3], b[3], c[3];
+        readPosition(positions, positionStride, source[t * 3], a);
+        readPosition(positions, positionStride, source[t * 3 + 1], b);
+        readPosition(positions, positionStride, source[t * 3 + 2], c);
+        float ab[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+        float ac[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+        // 叉积的长度为面积的两倍
+        float* normal = &triangleNormals[t * 3];
+        normal[0] = ab[1] * ac[2] - ab[2] * ac[1];
+        normal[1] = ab[2] * ac[0] - ab[0] * ac[2];
+        normal[2] = ab[0] * ac[1] - ab[1] * ac[0];
+        float area = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        for (int i = 0; i < 3; ++i)
+        {
+            triangleCentroids[t * 3 + i] = (a[i] + b[i] + c[i]) / 3.0f;
+            meshCentroid[i] += triangleCentroids[t * 3 + i] * area;
+        }
+        meshArea += area;
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+        meshCentroid[i] = meshArea > 0.0f ? meshCentroid[i] / meshArea : 0.0f;
+    }
+
+    for (Cluster& cluster : clusters)
+    {
+        float centroid[3] = { 0.0f, 0.0f, 0.0f };
+        float normal[3] = { 0.0f, 0.0f, 0.0f };
+        float area = 0.0f;
+        for (size_t t = cluster.begin; t < cluster.end; ++t)
+        {
+            const float* triangleNormal = &triangleNormals[t * 3];
+            float triangleArea = std::sqrt(triangleNormal[0] * triangleNormal[0] + triangleNormal[1] * triangleNormal[1]
+                + triangleNormal[2] * triangleNormal[2]);
+            for (int i = 0; i < 3; ++i)
+            {
+                centroid[i] += triangleCentroids[t * 3 + i] * triangleArea;
+                normal[i] += triangleNormal[i];
+            }
+            area += triangleArea;
+        }
+        float normalLength = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        cluster.sortKey = 0.0f;
+        if (area > 0.0f && normalLength > 0.0f)
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                cluster.sortKey += (centroid[i] / area - meshCentroid[i]) * normal[i] / normalLength;
+            }
+        }
+    }
+    std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& a, const Cluster& b)
+    {
+        return a.sortKey > b.sortKey;
+    });
+
+    size_t output = 0;
+    for (const Cluster& cluster : clusters)
+    {
+        size_t count = (cluster.end - cluster.begin) * 3;
+        memcpy(destination + output, &source[cluster.begin * 3], sizeof(unsigned int) * count);
+        output += count;
+    }
+}
+
+size_t optimizeVertexFetchRemap(unsigned int* remap, const unsigned int* indices, size_t indexCount, size_t vertexCount)
+{
+    std::fill(remap, remap + vertexCount, ~0u);
+    unsigned int next = 0;
+    for (size_t i = 0; i < indexCount; ++i)
+    {
+        if (remap[indices[i]] == ~0u)
+        {
+            remap[indices[i]] = next++;
+        }
+    }
+    return next;
+}
+
+void remapIndexBuffer(unsigned int* indices, size_t indexCount, const unsigned int* remap)
+{
+    for (size_t i = 0; i < indexCount; ++i)
+    {
+        indices[i] = remap[indices[i]];
+    }
+}
+
+void remapVertexBuffer(void* destination, const void* vertices, size_t vertexCount, size_t vertexSize, const unsigned int* remap)
+{
+    for (size_t v = 0; v < vertexCount; ++v)
+    {
+        if (remap[v] != ~0u)
+        {
+            memcpy(static_cast<char*>(destination) + remap[v] * vertexSize, static_cast<const char*>(vertices) + v * vertexSize, vertexSize);
+        }
+    }
+}
+
+size_t optimizeMesh(void* vertices, size_t vertexCount, size_t vertexSize, size_t positionOffset, std::vector<unsigned int>& indices)
+{
+    VertexCacheStats before = analyzeVertexCache(indices.data(), indices.size(), vertexCount);
+
+    optimizeVertexCache(indices.data(), indices.data(), indices.size(), vertexCount);
+    optimizeOverdraw(indices.data(), indices.data(), indices.size(),
+        static_cast<const char*>(vertices) + positionOffset, vertexCount, vertexSize);
+
+    std::vector<unsigned int> remap(vertexCount);
+    size_t remappedCount = optimizeVertexFetchRemap(remap.data(), indices.data(), indices.size(), vertexCount);
+    remapIndexBuffer(indices.data(), indices.size(), remap.data());
+    std::vector<char> original(static_cast<const char*>(vertices), static_cast<const char*>(vertices) + vertexCount * vertexSize);
+    remapVertexBuffer(vertices, original.data(), vertexCount, vertexSize, remap.data());
+
+    VertexCacheStats after = analyzeVertexCache(indices.data(), indices.size(), remappedCount);
+    std::cout << "MESH::OPTIMIZE triangles: " << indices.size() / 3 << " vertices: " << vertexCount << " -> " << remappedCount
+        << " ACMR: " << before.acmr << " -> " << after.acmr << " ATVR: " << before.atvr << " -> " << after.atvr << std::endl;
+    return remappedCount;
+}
+
+IndexData packIndices(const std::vector<unsigned int>& indices, size_t vertexCount)
+{
+    IndexData data;
+    data.count = indices.size();
+    // 0xFFFF 留给 primitive restart，只有顶点数小于 65536 时才用 16 位
+    if (vertexCount < 65536)
+    {
+        data.type = GL_UNSIGNED_SHORT;
+        data.bytes.resize(indices.size() * sizeof(uint16_t));
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            uint16_t index = (uint16_t)indices[i];
+            memcpy(&data.bytes[i * sizeof(uint16_t)], &index, sizeof(index));
+        }
+    }
+    else
+    {
+        data.type = GL_UNSIGNED_INT;
+        data.bytes.resize(indices.size() * sizeof(unsigned int));
+        memcpy(data.bytes.data(), indices.data(), data.bytes.size());
+    }
+    return data;
+}
@@ -0,0 +1,453 @@
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <unordered_set>
+
+namespace
+{
+    // 边界平面的权重，越大边界越不容易移动
+    const double kBorderWeight = 10.0;
+
+    // 对称 4x4 矩阵，只存上三角的 10 个元素；点 p 的误差为 [p, 1]^T Q [p, 1]，即到各平面距离的平方和
+    struct Quadric
+    {
+        double a2, ab, ac, ad, b2, bc, bd, c2, cd, d2;
+
+        void addPlane(double a, double b, double c, double d, double weight)
+        {
+            a2 += weight * a * a; ab += weight * a * b; ac += weight * a * c; ad += weight * a * d;
+            b2 += weight * b * b; bc += weight * b * c; bd += weight * b * d;
+            c2 += weight * c * c; cd += weight * c * d;
+            d2 += weight * d * d;
+        }
+
+        void add(const Quadric& other)
+        {
+            a2 += other.a2; ab += other.ab; ac += other.ac; ad += other.ad;
+            b2 += other.b2; bc += other.bc; bd += other.bd;
+            c2 += other.c2; cd += other.cd;
+            d2 += other.d2;
+        }
+
+        double evaluate(const float* p) const
+        {
+            double x = p[0], y = p[1], z = p[2];
+            double error = a2 * x * x + b2 * y * y + c2 * z * z + d2
+                + 2.0 * (ab * x * y + ac * x * z + bc * y * z + ad * x + bd * y + cd * z);
+            return std::max(error, 0.0);
+        }
+    };
+
+    struct Collapse
+    {
+        unsigned int from;
+        unsigned int to;
+        // 排序用的代价：位置误差加上属性误差
+        double cost;
+        // 只有位置的二次误差（距离的平方），用于误差上限和返回的 resultError
+        double error;
+    };
+
+    uint64_t getEdgeKey(unsigned int a, unsigned int b)
+    {
+        return a < b ? ((uint64_t)a << 32) | b : ((uint64_t)b << 32) | a;
+    }
+
+    void cross(const float* a, const float* b, float* result)
+    {
+        result[0] = a[1] * b[2] - a[2] * b[1];
+        result[1] = a[2] * b[0] - a[0] * b[2];
+        result[2] = a[0] * b[1] - a[1] * b[0];
+    }
+
+    void getTriangleNormal(const float* a, const float* b, const float* c, float* normal)
+    {
+        float ab[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+        float ac[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+        cross(ab, ac, normal);
+    }
+
+    class SimplifyContext
+    {
+    public:
+        SimplifyContext(const void* vertices, size_t vertexCount, size_t vertexSize, size_t positionOffset, const SimplifySettings& settings)
+            : positions(vertexCount * 3), settings(settings)
+        {
+            const char* data = static_cast<const char*>(vertices);
+            for (size_t v = 0; v < vertexCount; ++v)
+            {
+                memcpy(&positions[v * 3], data + v * vertexSize + positionOffset, sizeof(float) * 3);
+            }
+            if (settings.attributeCount > 0)
+            {
+                attributes.resize(vertexCount * settings.attributeCount);
+                for (size_t v = 0; v < vertexCount; ++v)
+                {
+                    memcpy(&attributes[v * settings.attributeCount], data + v * vertexSize + settings.attributeOffset,
+                        sizeof(float) * settings.attributeCount);
+                }
+            }
+        }
+
+        const float* getPosition(unsigned int vertex) const { return &positions[vertex * 3]; }
+
+        // 两端点的属性差，合并后 from 的属性被 to 代替
+        double getAttributeError(unsigned int from, unsigned int to) const
+        {
+            double error = 0.0;
+            for (size_t i = 0; i < settings.attributeCount; ++i)
+            {
+                double delta = attributes[from * settings.attributeCount + i] - attributes[to * settings.attributeCount + i];
+                error += delta * delta;
+            }
+            return error * settings.attributeWeight;
+        }
+    private:
+        std::vector<float> positions;
+        std::vector<float> attributes;
+        SimplifySettings settings;
+    };
+
+    void computeQuadrics(const SimplifyContext& context, const std::vector<unsigned int>& indices, size_t vertexCount,
+        const std::unordered_set<uint64_t>& borderEdges, std::vector<Quadric>& quadrics)
+    {
+        quadrics.assign(vertexCount, Quadric());
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            const float* p[3] = { context.getPosition(indices[i]), context.getPosition(indices[i + 1]), context.getPosition(indices[i + 2]) };
+            float normal[3];
+            getTriangleNormal(p[0], p[1], p[2], normal);
+            float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+            if (length <= 0.0f)
+            {
+                continue;
+            }
+            double a = normal[0] / length, b = normal[1] / length, c = normal[2] / length;
+            double d = -(a * p[0][0] + b * p[0][1] + c * p[0][2]);
+            for (int k = 0; k < 3; ++k)
+            {
+                quadrics[indices[i + k]].addPlane(a, b, c, d, 1.0);
+            }
+
+            // 边界边：加入经过这条边、垂直于三角形的平面
+            for (int k = 0; k < 3; ++k)
+            {
+                unsigned int from = indices[i + k];
+                unsigned int to = indices[i + (k + 1) % 3];
+                if (borderEdges.count(getEdgeKey(from, to)) == 0)
+                {
+                    continue;
+                }
+                const float* p0 = context.getPosition(from);
+                const float* p1 = context.getPosition(to);
+                float edge[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+                float unitNormal[3] = { (float)a, (float)b, (float)c };
+                float plane[3];
+                cross(edge, unitNormal, plane);
+                float planeLength = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+                if (planeLength <= 0.0f)
+                {
+                    continue;
+                }
+                double pa = plane[0] / planeLength, pb = plane[1] / planeLength, pc = plane[2] / planeLength;
+                double pd = -(pa * p0[0] + pb * p0[1] + pc * p0[2]);
+                quadrics[from].addPlane(pa, pb, pc, pd, kBorderWeight);
+                quadrics[to].addPlane(pa, pb, pc, pd, kBorderWeight);
+            }
+        }
+    }
+
+    // 只在一个三角形中出现的边
+    void findBorderEdges(const std::vector<unsigned int>& indices, std::unordered_set<uint64_t>& borderEdges,
+        std::vector<bool>& isBorder)
+    {
+        std::vector<uint64_t> edges;
+        edges.reserve(indices.size());
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                edges.push_back(getEdgeKey(indices[i + k], indices[i + (k + 1) % 3]));
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+        borderEdges.clear();
+        for (size_t i = 0; i < edges.size();)
+        {
+            size_t j = i;
+            while (j < edges.size() && edges[j] == edges[i])
+            {
+                ++j;
+            }
+            if (j - i == 1)
+            {
+                borderEdges.insert(edges[i]);
+                isBorder[(unsigned int)(edges[i] >> 32)] = true;
+                isBorder[(unsigned int)(edges[i] & 0xFFFFFFFF)] = true;
+            }
+            i = j;
+        }
+    }
+
+    // from 移动到 to 之后，from 周围（不包含 to）的三角形是否翻转
+    bool flipsTriangles(const SimplifyContext& context, const std::vector<unsigned int>& indices,
+        const std::vector<unsigned int>& triangles, unsigned int from, unsigned int to)
+    {
+        for (unsigned int triangle : triangles)
+        {
+            const unsigned int* corners = &indices[triangle * 3];
+            if (corners[0] == to || corners[1] == to || corners[2] == to)
+            {
+                continue;
+            }
+            const float* before[3];
+            const float* after[3];
+            for (int k = 0; k < 3; ++k)
+            {
+                before[k] = context.getPosition(corners[k]);
+                after[k] = corners[k] == from ? context.getPosition(to) : before[k];
+            }
+            float oldNormal[3];
+            float newNormal[3];
+            getTriangleNormal(before[0], before[1], before[2], oldNormal);
+            getTriangleNormal(after[0], after[1], after[2], newNormal);
+            if (oldNormal[0] * newNormal[0] + oldNormal[1] * newNormal[1] + oldNormal[2] * newNormal[2] <= 0.0f)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+size_t simplifyMesh(unsigned int* destination, const unsigned int* indices, size_t indexCount,
+    const void* vertices, size_t vertexCount, size_t vertexSize, size_t positionOffset,
+    size_t targetIndexCount, float targetError, const SimplifySettings& settings, float* resultError)
+{
+    SimplifyContext context(vertices, vertexCount, vertexSize, positionOffset, settings);
+    std::vector<unsigned int> result(indices, indices + indexCount / 3 * 3);
+
+    // 边界和二次误差只根据原始网格计算一次，之后合并时累加
+    std::unordered_set<uint64_t> borderEdges;
+    std::vector<bool> isBorder(vertexCount, false);
+    findBorderEdges(result, borderEdges, isBorder);
+    std::vector<Quadric> quadrics;
+    computeQuadrics(context, result, vertexCount, borderEdges, quadrics);
+
+    double maxErrorSquared = (double)targetError * targetError;
+    double resultErrorSquared = 0.0;
+    std::vector<unsigned int> remap(vertexCount);
+    std::vector<bool> locked(vertexCount);
+    std::vector<unsigned int> adjacencyOffset(vertexCount + 1);
+    std::vector<unsigned int> adjacency;
+    std::vector<uint64_t> edges;
+    std::vector<Collapse> collapses;
+    std::vector<unsigned int> triangles;
+
+    while (result.size() > targetIndexCount)
+    {
+        // 当前网格的所有边
+        edges.clear();
+        for (size_t i = 0; i < result.size(); i += 3)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                edges.push_back(getEdgeKey(result[i + k], result[i + (k + 1) % 3]));
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+        // 每条边取代价较小的方向；边界顶点只能沿边界边合并
+        collapses.clear();
+        for (uint64_t edge : edges)
+        {
+            unsigned int a = (unsigned int)(edge >> 32);
+            unsigned int b = (unsigned int)(edge & 0xFFFFFFFF);
+            bool onBorder = borderEdges.count(edge) != 0;
+            Collapse best = { 0, 0, DBL_MAX, DBL_MAX };
+            for (int direction = 0; direction < 2; ++direction)
+            {
+                unsigned int from = direction == 0 ? a : b;
+                unsigned int to = direction == 0 ? b : a;
+                if (isBorder[from] && !onBorder)
+                {
+                    continue;
+                }
+                Quadric quadric = quadrics[from];
+                quadric.add(quadrics[to]);
+                // 属性误差与位置误差单位不同，只参与排序，不计入屏幕空间误差
+                double error = quadric.evaluate(context.getPosition(to));
+                double cost = error + context.getAttributeError(from, to);
+                if (cost < best.cost)
+                {
+                    best = { from, to, cost, error };
+                }
+            }
+            if (best.error <= maxErrorSquared)
+            {
+                collapses.push_back(best);
+            }
+        }
+        if (collapses.empty())
+        {
+            break;
+        }
+        std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) { return a.cost < b.cost; });
+
+        // 顶点到三角形的邻接，用于翻转检查
+        std::fill(adjacencyOffset.begin(), adjacencyOffset.end(), 0);
+        for (unsigned int vertex : result)
+        {
+            ++adjacencyOffset[vertex + 1];
+        }
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            adjacencyOffset[v + 1] += adjacencyOffset[v];
+        }
+        adjacency.resize(result.size());
+        std::vector<unsigned int> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+        for (size_t i = 0; i < result.size(); ++i)
+        {
+            adjacency[fill[result[i]]++] = (unsigned int)(i / 3);
+        }
+
+        // 一次合并大约去掉两个三角形，够用时提前停止
+        size_t collapseLimit = (result.size() - targetIndexCount) / 6 + 1;
+        size_t applied = 0;
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            remap[v] = (unsigned int)v;
+        }
+        std::fill(locked.begin(), locked.end(), false);
+        for (const Collapse& collapse : collapses)
+        {
+            if (applied >= collapseLimit)
+            {
+                break;
+            }
+            // 同一轮中相邻的合并会互相影响翻转检查，已经被改动的区域留到下一轮
+            if (locked[collapse.from] || locked[collapse.to])
+            {
+                continue;
+            }
+            triangles.assign(adjacency.begin() + adjacencyOffset[collapse.from], adjacency.begin() + adjacencyOffset[collapse.from + 1]);
+            if (flipsTriangles(context, result, triangles, collapse.from, collapse.to))
+            {
+                continue;
+            }
+            remap[collapse.from] = collapse.to;
+            quadrics[collapse.to].add(quadrics[collapse.from]);
+            for (unsigned int triangle : triangles)
+            {
+                for (int k = 0; k < 3; ++k)
+                {
+                    locked[result[triangle * 3 + k]] = true;
+                }
+            }
+            resultErrorSquared = std::max(resultErrorSquared, collapse.error);
+            ++applied;
+        }
+        if (applied == 0)
+        {
+            break;
+        }
+
+        // 应用合并，去掉退化的三角形
+        size_t write = 0;
+        for (size_t i = 0; i < result.size(); i += 3)
+        {
+            unsigned int a = remap[result[i]];
+            unsigned int b = remap[result[i + 1]];
+            unsigned int c = remap[result[i + 2]];
+            if (a != b && b != c && a != c)
+            {
+                result[write++] = a;
+                result[write++] = b;
+                result[write++] = c;
+            }
+        }
+        result.resize(write);
+    }
+
+    std::copy(result.begin(), result.end(), destination);
+    if (resultError != nullptr)
+    {
+        *resultError = (float)std::sqrt(resultErrorSquared);
+    }
+    return result.size();
+}
+
+LodChain buildLodChain(const unsigned int* indices, size_t indexCount, const void* vertices, size_t vertexCount,
+    size_t vertexSize, size_t positionOffset, const LodSettings& settings)
+{
+    // 误差上限相对于包围盒对角线
+    float low[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float high[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (size_t v = 0; v < vertexCount; ++v)
+    {
+        float position[3];
+        memcpy(position, static_cast<const char*>(vertices) + v * vertexSize + positionOffset, sizeof(position));
+        for (int i = 0; i < 3; ++i)
+        {
+            low[i] = std::min(low[i], position[i]);
+            high[i] = std::max(high[i], position[i]);
+        }
+    }
+    float diagonal = 0.0f;
+    if (vertexCount > 0)
+    {
+        diagonal = std::sqrt((high[0] - low[0]) * (high[0] - low[0]) + (high[1] - low[1]) * (high[1] - low[1])
+            + (high[2] - low[2]) * (high[2] - low[2]));
+    }
+
+    LodChain chain;
+    chain.indices.assign(indices, indices + indexCount);
+    chain.lods.push_back({ 0, (unsigned int)indexCount, 0.0f });
+
+    std::vector<unsigned int> previous(indices, indices + indexCount);
+    std::vector<unsigned int> simplified(indexCount);
+    for (int level = 1; level < settings.maxLods; ++level)
+    {
+        size_t target = (size_t)(previous.size() / 3 * settings.reduction) * 3;
+        float error = 0.0f;
+        size_t count = simplifyMesh(simplified.data(), previous.data(), previous.size(), vertices, vertexCount, vertexSize,
+            positionOffset, target, settings.maxError * diagonal, settings, &error);
+        // 减少得太少的一级不值得占用显存
+        if (count == 0 || count > previous.size() * 9 / 10)
+        {
+            break;
+        }
+        simplified.resize(count);
+        optimizeVertexCache(simplified.data(), simplified.data(), count, vertexCount);
+
+        // 每一级从上一级简化而来，误差累加
+        MeshLod lod = { (unsigned int)chain.indices.size(), (unsigned int)count, chain.lods.back().error + error };
+        chain.indices.insert(chain.indices.end(), simplified.begin(), simplified.end());
+        chain.lods.push_back(lod);
+        previous.swap(simplified);
+        simplified.resize(previous.size());
+    }
+    return chain;
+}
+
+float getPixelsPerUnit(float distance, float fovY, float screenHeight)
+{
+    return screenHeight / (2.0f * std::max(distance, 1e-4f) * std::tan(fovY * 0.5f));
+}
+
+size_t selectLod(const std::vector<MeshLod>& lods, float pixelsPerUnit, float pixelThreshold)
+{
+    // error 随级别单调增加，从最粗糙的一级往回找
+    for (size_t i = lods.size(); i > 1; --i)
+    {
+        if (lods[i - 1].error * pixelsPerUnit <= pixelThreshold)
+        {
+            return i - 1;
+        }
+    }
+    return 0;
+}
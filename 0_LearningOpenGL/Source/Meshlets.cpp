@@ -0,0 +1,343 @@
+#include "Meshlets.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+    void getPosition(const void* vertices, size_t vertexSize, size_t positionOffset, unsigned int vertex, float* position)
+    {
+        memcpy(position, static_cast<const char*>(vertices) + vertex * vertexSize + positionOffset, sizeof(float) * 3);
+    }
+
+    float normalize(float* v)
+    {
+        float length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        if (length > 0.0f)
+        {
+            v[0] /= length;
+            v[1] /= length;
+            v[2] /= length;
+        }
+        return length;
+    }
+
+    // 计算一个簇的包围球和法线锥
+    void computeBounds(Meshlet& meshlet, const unsigned int* indices, const void* vertices, size_t vertexSize, size_t positionOffset)
+    {
+        size_t triangleCount = meshlet.indexCount / 3;
+        std::vector<float> corners(triangleCount * 9);
+        std::vector<float> normals(triangleCount * 3);
+        float low[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+        float high[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            float* p = &corners[t * 9];
+            for (int k = 0; k < 3; ++k)
+            {
+                getPosition(vertices, vertexSize, positionOffset, indices[meshlet.indexOffset + t * 3 + k], p + k * 3);
+                for (int i = 0; i < 3; ++i)
+                {
+                    low[i] = std::min(low[i], p[k * 3 + i]);
+                    high[i] = std::max(high[i], p[k * 3 + i]);
+                }
+            }
+            float ab[3] = { p[3] - p[0], p[4] - p[1], p[5] - p[2] };
+            float ac[3] = { p[6] - p[0], p[7] - p[1], p[8] - p[2] };
+            float* normal = &normals[t * 3];
+            normal[0] = ab[1] * ac[2] - ab[2] * ac[1];
+            normal[1] = ab[2] * ac[0] - ab[0] * ac[2];
+            normal[2] = ab[0] * ac[1] - ab[1] * ac[0];
+            normalize(normal);
+        }
+
+        // 包围盒中心为球心，半径取最远的顶点
+        float radiusSquared = 0.0f;
+        for (int i = 0; i < 3; ++i)
+        {
+            meshlet.center[i] = (low[i] + high[i]) * 0.5f;
+        }
+        for (size_t c = 0; c < triangleCount * 3; ++c)
+        {
+            const float* p = &corners[c * 3];
+            float dx = p[0] - meshlet.center[0], dy = p[1] - meshlet.center[1], dz = p[2] - meshlet.center[2];
+            radiusSquared = std::max(radiusSquared, dx * dx + dy * dy + dz * dz);
+        }
+        meshlet.radius = std::sqrt(radiusSquared);
+
+        // 锥轴为法线的平均方向，锥的半角由与轴夹角最大的法线决定
+        float axis[3] = { 0.0f, 0.0f, 0.0f };
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            axis[0] += normals[t * 3];
+            axis[1] += normals[t * 3 + 1];
+            axis[2] += normals[t * 3 + 2];
+        }
+        float minDot = 1.0f;
+        if (normalize(axis) > 0.0f)
+        {
+            for (size_t t = 0; t < triangleCount; ++t)
+            {
+                const float* normal = &normals[t * 3];
+                minDot = std::min(minDot, normal[0] * axis[0] + normal[1] * axis[1] + normal[2] * axis[2]);
+            }
+        }
+        else
+        {
+            minDot = -1.0f;
+        }
+        // 锥的半角超过 90 度时没有一个方向能同时看到所有三角形的背面，这个簇不参与锥剔除
+        if (minDot <= 0.0f)
+        {
+            memcpy(meshlet.coneApex, meshlet.center, sizeof(meshlet.center));
+            meshlet.coneAxis[0] = meshlet.coneAxis[1] = meshlet.coneAxis[2] = 0.0f;
+            meshlet.coneCutoff = 1.0f;
+            return;
+        }
+
+        // 锥顶沿轴后退，直到所有三角形所在的平面都在锥顶前方
+        float maxT = 0.0f;
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            const float* p = &corners[t * 9];
+            const float* normal = &normals[t * 3];
+            float dc = (meshlet.center[0] - p[0]) * normal[0] + (meshlet.center[1] - p[1]) * normal[1] + (meshlet.center[2] - p[2]) * normal[2];
+            float dn = axis[0] * normal[0] + axis[1] * normal[1] + axis[2] * normal[2];
+            maxT = std::max(maxT, dc / dn);
+        }
+        for (int i = 0; i < 3; ++i)
+        {
+            meshlet.coneApex[i] = meshlet.center[i] - axis[i] * maxT;
+            meshlet.coneAxis[i] = axis[i];
+        }
+        // 观察方向与轴的夹角小于 90 度减去半角时整个簇都是背面，cutoff = cos(90 度 - 半角) = sin(半角)
+        meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+    }
+
+    void extractPlanes(const Mat4& matrix, Vec4* planes)
+    {
+        // 列主序：第 i 行为 (m[i], m[4 + i], m[8 + i], m[12 + i])
+        const float* m = matrix.m;
+        for (int i = 0; i < 3; ++i)
+        {
+            planes[i * 2] = { m[3] + m[i], m[7] + m[4 + i], m[11] + m[8 + i], m[15] + m[12 + i] };
+            planes[i * 2 + 1] = { m[3] - m[i], m[7] - m[4 + i], m[11] - m[8 + i], m[15] - m[12 + i] };
+        }
+        for (int i = 0; i < 6; ++i)
+        {
+            float length = std::sqrt(planes[i].x * planes[i].x + planes[i].y * planes[i].y + planes[i].z * planes[i].z);
+            if (length > 0.0f)
+            {
+                planes[i].x /= length;
+                planes[i].y /= length;
+                planes[i].z /= length;
+                planes[i].w /= length;
+            }
+        }
+    }
+
+    bool isOutsideFrustum(const Meshlet& meshlet, const MeshletCullView& view)
+    {
+        for (const Vec4& plane : view.planes)
+        {
+            if (plane.x * meshlet.center[0] + plane.y * meshlet.center[1] + plane.z * meshlet.center[2] + plane.w < -meshlet.radius)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool isBackfacing(const Meshlet& meshlet, const MeshletCullView& view)
+    {
+        float direction[3];
+        if (view.perspective)
+        {
+            direction[0] = meshlet.coneApex[0] - view.cameraPosition.x;
+            direction[1] = meshlet.coneApex[1] - view.cameraPosition.y;
+            direction[2] = meshlet.coneApex[2] - view.cameraPosition.z;
+            normalize(direction);
+        }
+        else
+        {
+            direction[0] = view.viewDirection.x;
+            direction[1] = view.viewDirection.y;
+            direction[2] = view.viewDirection.z;
+        }
+        float d = direction[0] * meshlet.coneAxis[0] + direction[1] * meshlet.coneAxis[1] + direction[2] * meshlet.coneAxis[2];
+        // coneCutoff 为 1 的簇不参与锥剔除
+        return meshlet.coneCutoff < 1.0f && d >= meshlet.coneCutoff;
+    }
+}
+
+std::vector<Meshlet> buildMeshlets(const unsigned int* indices, size_t indexCount, const void* vertices, size_t vertexCount,
+    size_t vertexSize, size_t positionOffset, size_t maxVertices, size_t maxTriangles)
+{
+    std::vector<Meshlet> meshlets;
+    // 记录顶点最后一次被加入的簇，判断顶点是否已经在当前簇中
+    std::vector<unsigned int> owner(vertexCount, ~0u);
+    Meshlet current = {};
+    for (size_t i = 0; i + 2 < indexCount; i += 3)
+    {
+        unsigned int meshletId = (unsigned int)meshlets.size();
+        size_t newVertices = 0;
+        for (int k = 0; k < 3; ++k)
+        {
+            unsigned int vertex = indices[i + k];
+            // 同一个三角形中重复的顶点只计一次
+            bool repeated = (k > 0 && vertex == indices[i]) || (k > 1 && vertex == indices[i + 1]);
+            if (owner[vertex] != meshletId && !repeated)
+            {
+                ++newVertices;
+            }
+        }
+        if (current.indexCount > 0
+            && (current.vertexCount + newVertices > maxVertices || current.indexCount / 3 + 1 > maxTriangles))
+        {
+            meshlets.push_back(current);
+            current = {};
+            current.indexOffset = (unsigned int)i;
+            meshletId = (unsigned int)meshlets.size();
+        }
+        for (int k = 0; k < 3; ++k)
+        {
+            unsigned int vertex = indices[i + k];
+            if (owner[vertex] != meshletId)
+            {
+                owner[vertex] = meshletId;
+                ++current.vertexCount;
+            }
+        }
+        current.indexCount += 3;
+    }
+    if (current.indexCount > 0)
+    {
+        meshlets.push_back(current);
+    }
+
+    for (Meshlet& meshlet : meshlets)
+    {
+        computeBounds(meshlet, indices, vertices, vertexSize, positionOffset);
+    }
+    return meshlets;
+}
+
+MeshletCullView makePerspectiveCullView(const Mat4& viewProjection, const Vec3& cameraPosition, bool coneCulling)
+{
+    MeshletCullView view;
+    extractPlanes(viewProjection, view.planes);
+    view.perspective = true;
+    view.cameraPosition = cameraPosition;
+    view.viewDirection = { 0.0f, 0.0f, 0.0f };
+    view.coneCulling = coneCulling;
+    return view;
+}
+
+MeshletCullView makeOrthographicCullView(const Mat4& viewProjection, const Vec3& viewDirection, bool coneCulling)
+{
+    MeshletCullView view;
+    extractPlanes(viewProjection, view.planes);
+    view.perspective = false;
+    view.cameraPosition = { 0.0f, 0.0f, 0.0f };
+    view.viewDirection = viewDirection;
+    view.coneCulling = coneCulling;
+    return view;
+}
+
+void printMeshletCullStats(const MeshletCullStats& stats)
+{
+    size_t frames = std::max<size_t>(stats.frames, 1);
+    size_t triangles = stats.trianglesSubmitted + stats.trianglesCulled;
+    std::cout << "MESHLET::CULL frames: " << stats.frames
+        << " meshlets/frame: " << stats.meshlets / frames
+        << " visible: " << stats.visibleMeshlets / frames
+        << " frustum culled: " << stats.frustumCulled / frames
+        << " cone culled: " << stats.coneCulled / frames
+        << " triangles submitted: " << stats.trianglesSubmitted / frames
+        << " culled: " << stats.trianglesCulled / frames
+        << " (" << (triangles > 0 ? 100.0 * stats.trianglesCulled / triangles : 0.0) << "%)"
+        << " draw ranges: " << stats.drawRanges / frames << std::endl;
+}
+
+void MeshletDrawList::clear()
+{
+    firsts.clear();
+    counts.clear();
+    offsets.clear();
+}
+
+void MeshletDrawList::add(unsigned int indexOffset, unsigned int indexCount)
+{
+    if (!counts.empty() && firsts.back() + (unsigned int)counts.back() == indexOffset)
+    {
+        counts.back() += (GLsizei)indexCount;
+        return;
+    }
+    firsts.push_back(indexOffset);
+    counts.push_back((GLsizei)indexCount);
+}
+
+void MeshletDrawList::draw(GLenum indexType, size_t indexSize, int baseVertex)
+{
+    if (counts.empty())
+    {
+        return;
+    }
+    offsets.resize(firsts.size());
+    for (size_t i = 0; i < firsts.size(); ++i)
+    {
+        offsets[i] = (const void*)(firsts[i] * indexSize);
+    }
+    if (baseVertex == 0)
+    {
+        glMultiDrawElements(GL_TRIANGLES, counts.data(), indexType, offsets.data(), (GLsizei)counts.size());
+        return;
+    }
+    baseVertices.assign(counts.size(), baseVertex);
+    glMultiDrawElementsBaseVertex(GL_TRIANGLES, counts.data(), indexType, offsets.data(), (GLsizei)counts.size(), baseVertices.data());
+}
+
+void cullMeshlets(const std::vector<Meshlet>& meshlets, const MeshletCullView& view, unsigned int baseIndex,
+    MeshletDrawList& drawList, MeshletCullStats* stats)
+{
+    size_t visible = 0;
+    size_t frustumCulled = 0;
+    size_t coneCulled = 0;
+    size_t trianglesSubmitted = 0;
+    size_t trianglesCulled = 0;
+    for (const Meshlet& meshlet : meshlets)
+    {
+        bool culled = false;
+        if (isOutsideFrustum(meshlet, view))
+        {
+            ++frustumCulled;
+            culled = true;
+        }
+        else if (view.coneCulling && isBackfacing(meshlet, view))
+        {
+            ++coneCulled;
+            culled = true;
+        }
+
+        if (culled)
+        {
+            trianglesCulled += meshlet.indexCount / 3;
+            continue;
+        }
+        ++visible;
+        trianglesSubmitted += meshlet.indexCount / 3;
+        drawList.add(baseIndex + meshlet.indexOffset, meshlet.indexCount);
+    }
+
+    if (stats != nullptr)
+    {
+        stats->meshlets += meshlets.size();
+        stats->visibleMeshlets += visible;
+        stats->frustumCulled += frustumCulled;
+        stats->coneCulled += coneCulled;
+        stats->trianglesSubmitted += trianglesSubmitted;
+        stats->trianglesCulled += trianglesCulled;
+    }
+}
@@ -0,0 +1,159 @@
+#include "MultiDrawBatcher.h"
+#include "GLExtensions.h"
+#include "GLState.h"
+#include "VertexArrayCache.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+MultiDrawBatcher::MultiDrawBatcher(StreamBuffer& stream)
+    : stream(stream)
+{
+}
+
+void MultiDrawBatcher::begin(const VertexLayout& meshLayout, Shader& shader, const VertexLayout& drawLayout)
+{
+    this->meshLayout = &meshLayout;
+    this->shader = &shader;
+    this->drawLayout = &drawLayout;
+    draws.clear();
+    drawData.clear();
+}
+
+void MultiDrawBatcher::add(MeshHandle mesh, const void* data)
+{
+    GeometryBuffer& geometry = GeometryBuffer::instance();
+    if (drawLayout == nullptr || !geometry.isValid(mesh))
+    {
+        return;
+    }
+    GeometryRange range = geometry.get(mesh);
+    draws.push_back(Draw{ mesh, range.vertexBuffer, range.indexBuffer, range.indexType });
+    size_t offset = drawData.size();
+    drawData.resize(offset + drawLayout->stride);
+    memcpy(drawData.data() + offset, data, drawLayout->stride);
+}
+
+void MultiDrawBatcher::submit()
+{
+    if (draws.empty())
+    {
+        return;
+    }
+
+    // 同一个顶点缓冲、索引缓冲和索引类型的物体相邻，每组一次 MDI
+    drawOrder.resize(draws.size());
+    for (size_t i = 0; i < draws.size(); ++i)
+    {
+        drawOrder[i] = i;
+    }
+    std::sort(drawOrder.begin(), drawOrder.end(), [this](size_t a, size_t b)
+    {
+        const Draw& left = draws[a];
+        const Draw& right = draws[b];
+        if (left.vertexBuffer != right.vertexBuffer)
+        {
+            return left.vertexBuffer < right.vertexBuffer;
+        }
+        if (left.indexBuffer != right.indexBuffer)
+        {
+            return left.indexBuffer < right.indexBuffer;
+        }
+        return left.indexType < right.indexType;
+    });
+
+    // 物体数据按排序后的顺序写入，每组的数据连续，组内的下标就是 baseInstance
+    unsigned int stride = drawLayout->stride;
+    StreamBufferRange dataRange = stream.allocateVertices((unsigned int)(draws.size() * stride), stride);
+    bool indirect = glExtensions.multiDrawIndirect;
+    StreamBufferRange commandRange = {};
+    if (indirect)
+    {
+        commandRange = stream.allocate((unsigned int)(draws.size() * sizeof(DrawElementsIndirectCommand)), 4);
+    }
+    if (dataRange.data == nullptr || (indirect && commandRange.data == nullptr))
+    {
+        draws.clear();
+        drawData.clear();
+        return;
+    }
+
+    GeometryBuffer& geometry = GeometryBuffer::instance();
+    DrawElementsIndirectCommand* commands = static_cast<DrawElementsIndirectCommand*>(commandRange.data);
+    size_t groupStart = 0;
+    for (size_t i = 0; i < drawOrder.size(); ++i)
+    {
+        const Draw& draw = draws[drawOrder[i]];
+        memcpy(static_cast<char*>(dataRange.data) + i * stride, drawData.data() + drawOrder[i] * stride, stride);
+        if (i > 0)
+        {
+            const Draw& previous = draws[drawOrder[i - 1]];
+            if (previous.vertexBuffer != draw.vertexBuffer || previous.indexBuffer != draw.indexBuffer || previous.indexType != draw.indexType)
+            {
+                groupStart = i;
+            }
+        }
+        if (indirect)
+        {
+            GeometryRange range = geometry.get(draw.mesh);
+            DrawElementsIndirectCommand command = { range.indexCount, 1, range.firstIndex, (GLint)range.baseVertex, (GLuint)(i - groupStart) };
+            memcpy(&commands[i], &command, sizeof(command));
+        }
+    }
+    stream.flush();
+
+    VertexArrayCache& vertexArrays = VertexArrayCache::instance();
+    shader->use();
+    for (size_t start = 0; start < drawOrder.size();)
+    {
+        const Draw& first = draws[drawOrder[start]];
+        size_t end = start + 1;
+        while (end < drawOrder.size())
+        {
+            const Draw& draw = draws[drawOrder[end]];
+            if (draw.vertexBuffer != first.vertexBuffer || draw.indexBuffer != first.indexBuffer || draw.indexType != first.indexType)
+            {
+                break;
+            }
+            ++end;
+        }
+
+        if (indirect)
+        {
+            // 实例属性从本组第一个物体的数据开始，命令的 baseInstance 再选出各自的那一份
+            vertexArrays.bind(*meshLayout, *drawLayout, *shader, first.vertexBuffer, stream.getBuffer(),
+                (unsigned int)(dataRange.offset + start * stride), first.indexBuffer);
+            GLState::instance().bindBuffer(GL_DRAW_INDIRECT_BUFFER, stream.getBuffer());
+            glMultiDrawElementsIndirect(GL_TRIANGLES, first.indexType,
+                (const void*)(commandRange.offset + start * sizeof(DrawElementsIndirectCommand)), (GLsizei)(end - start), 0);
+            ++calls;
+        }
+        else
+        {
+            for (size_t i = start; i < end; ++i)
+            {
+                GeometryRange range = geometry.get(draws[drawOrder[i]].mesh);
+                vertexArrays.bind(*meshLayout, *drawLayout, *shader, range.vertexBuffer, stream.getBuffer(),
+                    (unsigned int)(dataRange.offset + i * stride), range.indexBuffer);
+                glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)range.indexCount, range.indexType,
+                    (void*)(range.firstIndex * range.getIndexSize()), (GLint)range.baseVertex);
+                ++calls;
+            }
+        }
+        start = end;
+    }
+
+    ++frames;
+    objects += (unsigned int)draws.size();
+    draws.clear();
+    drawData.clear();
+}
+
+void MultiDrawBatcher::printStats() const
+{
+    unsigned int frameCount = std::max(frames, 1u);
+    std::cout << "MULTI_DRAW::STATS mode: " << (glExtensions.multiDrawIndirect ? "indirect" : "base vertex loop")
+        << " frames: " << frames
+        << " objects/frame: " << objects / frameCount
+        << " draw calls/frame: " << calls / frameCount << std::endl;
+}
@@ -0,0 +1,103 @@
+#include "OffsetAllocator.h"
+#include <iostream>
+
+OffsetAllocator::OffsetAllocator(unsigned int capacity)
+{
+    reset(capacity);
+}
+
+void OffsetAllocator::reset(unsigned int capacity)
+{
+    this->capacity = capacity;
+    used = 0;
+    freeByOffset.clear();
+    freeBySize.clear();
+    if (capacity > 0)
+    {
+        insertFree(0, capacity);
+    }
+}
+
+OffsetAllocation OffsetAllocator::allocate(unsigned int size)
+{
+    auto it = freeBySize.lower_bound(size);
+    if (size == 0 || it == freeBySize.end())
+    {
+        return OffsetAllocation{ 0, 0 };
+    }
+    unsigned int blockSize = it->first;
+    unsigned int blockOffset = it->second;
+    eraseFree(blockOffset, blockSize);
+    // 剩余部分放回空闲块
+    if (blockSize > size)
+    {
+        insertFree(blockOffset + size, blockSize - size);
+    }
+    used += size;
+    return OffsetAllocation{ blockOffset, size };
+}
+
+void OffsetAllocator::free(const OffsetAllocation& allocation)
+{
+    if (!allocation.isValid())
+    {
+        return;
+    }
+    unsigned int offset = allocation.offset;
+    unsigned int size = allocation.size;
+    // 重复释放或与已有空闲块重叠的区间会让之后的分配互相覆盖，只检查前后相邻的两个空闲块即可
+    auto next = freeByOffset.lower_bound(offset);
+    auto previous = next;
+    bool overlaps = next != freeByOffset.end() && next->first < offset + size;
+    if (previous != freeByOffset.begin())
+    {
+        --previous;
+        overlaps = overlaps || previous->first + previous->second > offset;
+    }
+    if (offset > capacity || size > capacity - offset || size > used || overlaps)
+    {
+        std::cout << "ERROR::OFFSET_ALLOCATOR::INVALID_FREE " << allocation.offset << " " << allocation.size << std::endl;
+        return;
+    }
+    used -= size;
+
+    // 与后面紧邻的空闲块合并
+    if (next != freeByOffset.end() && next->first == offset + size)
+    {
+        size += next->second;
+        eraseFree(next->first, next->second);
+    }
+    // 与前面紧邻的空闲块合并
+    previous = freeByOffset.lower_bound(offset);
+    if (previous != freeByOffset.begin())
+    {
+        --previous;
+        if (previous->first + previous->second == offset)
+        {
+            offset = previous->first;
+            size += previous->second;
+            eraseFree(previous->first, previous->second);
+        }
+    }
+    insertFree(offset, size);
+}
+
+void OffsetAllocator::insertFree(unsigned int offset, unsigned int size)
+{
+    freeByOffset[offset] = size;
+    freeBySize.insert(std::make_pair(size, offset));
+}
+
+void OffsetAllocator::eraseFree(unsigned int offset, unsigned int size)
+{
+    freeByOffset.erase(offset);
+    auto range = freeBySize.equal_range(size);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second == offset)
+        {
+            freeBySize.erase(it);
+            break;
+        }
+    }
+}
@@ -1,68 +1,631 @@
 ﻿#include "Shader.h"
+#include "GLExtensions.h"
+#include "ShaderCache.h"
+#include "FileWatcher.h"
+#include "GLState.h"
+#include "ShaderPreprocessor.h"
+#include "ShaderTelemetry.h"
+#include "UniformBuffer.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
 
+namespace
+{
+    // 映射离线生成的 SPIR-V 模块（嵌入的数据直接指向可执行文件），文件不存在或大小不对时返回未打开的映射
+    MappedFile readSpirv(const std::string& path)
+    {
+        MappedFile spirv;
+        if (spirv.open(path, false) && spirv.size() % 4 != 0)
+        {
+            spirv.close();
+        }
+        return spirv;
+    }
+
+    // 模块中声明的特化常量 ID（OpDecorate <id> SpecId <literal>）
+    // 传给 glSpecializeShader 的常量必须存在于模块中，否则整个特化失败
+    std::vector<unsigned int> getSpecializationIds(const char* spirv, size_t size)
+    {
+        const uint32_t kOpDecorate = 71;
+        const uint32_t kDecorationSpecId = 1;
+        // 嵌入的数据不保证 4 字节对齐，逐个字 memcpy 读取，不拷贝整个模块
+        size_t wordTotal = size / 4;
+        auto word = [spirv](size_t index)
+        {
+            uint32_t value;
+            memcpy(&value, spirv + index * 4, 4);
+            return value;
+        };
+
+        std::vector<unsigned int> ids;
+        // 前 5 个字是模块头
+        for (size_t i = 5; i < wordTotal;)
+        {
+            uint32_t instruction = word(i);
+            uint32_t wordCount = instruction >> 16;
+            uint32_t opcode = instruction & 0xFFFF;
+            if (wordCount == 0 || i + wordCount > wordTotal)
+            {
+                break;
+            }
+            if (opcode == kOpDecorate && wordCount == 4 && word(i + 2) == kDecorationSpecId)
+            {
+                ids.push_back(word(i + 3));
+            }
+            i += wordCount;
+        }
+        return ids;
+    }
+
+    // SPIR-V 中的名字（OpName）是可选的，有的驱动不保留，这时按名字反射的 uniform/顶点输入都无法使用
+    bool hasReflectionNames(unsigned int program)
+    {
+        char name[2] = {};
+        int length = 0;
+        int count = 0;
+        glGetProgramiv(program, GL_ACTIVE_ATTRIBUTES, &count);
+        if (count > 0)
+        {
+            int size = 0;
+            GLenum type = 0;
+            glGetActiveAttrib(program, 0, sizeof(name), &length, &size, &type, name);
+            if (length == 0)
+            {
+                return false;
+            }
+        }
+        glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+        if (count > 0)
+        {
+            glGetActiveUniformBlockName(program, 0, sizeof(name), &length, name);
+            if (length == 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::string buildConstantDefines(const std::vector<SpecializationConstant>& constants)
+    {
+        std::string defines;
+        for (const SpecializationConstant& constant : constants)
+        {
+            defines += "#define " + constant.name + " " + std::to_string(constant.value) + "\n";
+        }
+        return defines;
+    }
+
+    // 按类型读取 from 中的 uniform 值并写入 to 中同名的 uniform，要求 to 是当前 program
+    void copyUniformValue(unsigned int from, int fromLocation, int toLocation, GLenum type)
+    {
+        float f[16];
+        int i[4];
+        unsigned int u[4];
+        switch (type)
+        {
+        case GL_FLOAT: glGetUniformfv(from, fromLocation, f); glUniform1fv(toLocation, 1, f); break;
+        case GL_FLOAT_VEC2: glGetUniformfv(from, fromLocation, f); glUniform2fv(toLocation, 1, f); break;
+        case GL_FLOAT_VEC3: glGetUniformfv(from, fromLocation, f); glUniform3fv(toLocation, 1, f); break;
+        case GL_FLOAT_VEC4: glGetUniformfv(from, fromLocation, f); glUniform4fv(toLocation, 1, f); break;
+        case GL_FLOAT_MAT2: glGetUniformfv(from, fromLocation, f); glUniformMatrix2fv(toLocation, 1, GL_FALSE, f); break;
+        case GL_FLOAT_MAT3: glGetUniformfv(from, fromLocation, f); glUniformMatrix3fv(toLocation, 1, GL_FALSE, f); break;
+        case GL_FLOAT_MAT4: glGetUniformfv(from, fromLocation, f); glUniformMatrix4fv(toLocation, 1, GL_FALSE, f); break;
+        case GL_INT_VEC2: case GL_BOOL_VEC2: glGetUniformiv(from, fromLocation, i); glUniform2iv(toLocation, 1, i); break;
+        case GL_INT_VEC3: case GL_BOOL_VEC3: glGetUniformiv(from, fromLocation, i); glUniform3iv(toLocation, 1, i); break;
+        case GL_INT_VEC4: case GL_BOOL_VEC4: glGetUniformiv(from, fromLocation, i); glUniform4iv(toLocation, 1, i); break;
+        case GL_UNSIGNED_INT: glGetUniformuiv(from, fromLocation, u); glUniform1uiv(toLocation, 1, u); break;
+        case GL_UNSIGNED_INT_VEC2: glGetUniformuiv(from, fromLocation, u); glUniform2uiv(toLocation, 1, u); break;
+        case GL_UNSIGNED_INT_VEC3: glGetUniformuiv(from, fromLocation, u); glUniform3uiv(toLocation, 1, u); break;
+        case GL_UNSIGNED_INT_VEC4: glGetUniformuiv(from, fromLocation, u); glUniform4uiv(toLocation, 1, u); break;
+        default:
+            // int、bool 以及各种 sampler 都以 int 存储
+            glGetUniformiv(from, fromLocation, i);
+            glUniform1iv(toLocation, 1, i);
+            break;
+        }
+    }
+
+    // 热重载时保留旧 program 的状态：uniform 的值以及 uniform block 的绑定点
+    void copyProgramState(unsigned int from, unsigned int to)
+    {
+        GLState::instance().useProgram(to);
+
+        int activeCount = 0;
+        int maxLength = 0;
+        glGetProgramiv(from, GL_ACTIVE_UNIFORMS, &activeCount);
+        glGetProgramiv(from, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+        std::vector<char> nameBuffer(maxLength > 0 ? maxLength : 1);
+        for (int index = 0; index < activeCount; ++index)
+        {
+            int length = 0;
+            int arraySize = 0;
+            GLenum type = 0;
+            glGetActiveUniform(from, index, (GLsizei)nameBuffer.size(), &length, &arraySize, &type, nameBuffer.data());
+            std::string name(nameBuffer.data(), length);
+            if (name.size() >= 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
+            {
+                name.resize(name.size() - 3);
+            }
+            else
+            {
+                arraySize = 1;
+            }
+
+            for (int element = 0; element < arraySize; ++element)
+            {
+                std::string elementName = arraySize > 1 ? name + "[" + std::to_string(element) + "]" : name;
+                int fromLocation = glGetUniformLocation(from, elementName.c_str());
+                int toLocation = glGetUniformLocation(to, elementName.c_str());
+                if (fromLocation >= 0 && toLocation >= 0)
+                {
+                    copyUniformValue(from, fromLocation, toLocation, type);
+                }
+            }
+        }
+
+        int blockCount = 0;
+        glGetProgramiv(from, GL_ACTIVE_UNIFORM_BLOCKS, &blockCount);
+        glGetProgramiv(from, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxLength);
+        nameBuffer.resize(maxLength > 0 ? maxLength : 1);
+        for (int block = 0; block < blockCount; ++block)
+        {
+            int binding = 0;
+            glGetActiveUniformBlockName(from, block, (GLsizei)nameBuffer.size(), NULL, nameBuffer.data());
+            glGetActiveUniformBlockiv(from, block, GL_UNIFORM_BLOCK_BINDING, &binding);
+            unsigned int toBlock = glGetUniformBlockIndex(to, nameBuffer.data());
+            if (toBlock != GL_INVALID_INDEX)
+            {
+                glUniformBlockBinding(to, toBlock, binding);
+            }
+        }
+    }
+}
 
-Shader::Shader(const char* vertexPath, const char* fragmentPath)
+void reflectShaderAttributes(unsigned int program, std::vector<ShaderAttribute>& attributes, uint64_t& signature)
 {
-    // 1. 从文件路径中获取顶点/片段着色器
-    std::string vertexCode;
-    std::string fragmentCode;
-    std::ifstream vShaderFile;
-    std::ifstream fShaderFile;
+    attributes.clear();
 
-    // 保证ifstream对象可以抛出异常
-    vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    try
+    int activeCount = 0;
+    int maxLength = 0;
+    glGetProgramiv(program, GL_ACTIVE_ATTRIBUTES, &activeCount);
+    glGetProgramiv(program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxLength);
+    std::vector<char> nameBuffer(maxLength > 0 ? maxLength : 1);
+    for (int i = 0; i < activeCount; ++i)
     {
-        // 打开文件
-        vShaderFile.open(vertexPath);
-        fShaderFile.open(fragmentPath);
-        std::stringstream vShaderStream, fShaderStream;
-        // 读取文件的缓冲内容到数据流中
-        vShaderStream << vShaderFile.rdbuf();
-        fShaderStream << fShaderFile.rdbuf();
-        // 关闭文件处理器
-        vShaderFile.close();
-        fShaderFile.close();
-        // 转换数据流到 string
-        vertexCode = vShaderStream.str();
-        fragmentCode = fShaderStream.str();
+        int length = 0;
+        int size = 0;
+        GLenum type = 0;
+        glGetActiveAttrib(program, i, (GLsizei)nameBuffer.size(), &length, &size, &type, nameBuffer.data());
+        // gl_VertexID 等内置变量没有 location
+        int location = glGetAttribLocation(program, nameBuffer.data());
+        if (location < 0)
+        {
+            continue;
+        }
+        std::string name(nameBuffer.data(), length);
+        attributes.push_back(ShaderAttribute{ name, hashString(name.c_str(), name.size()), location, type });
     }
-    catch (std::ifstream::failure e)
+
+    std::sort(attributes.begin(), attributes.end(),
+        [](const ShaderAttribute& a, const ShaderAttribute& b) { return a.location < b.location; });
+    signature = hashBytes64(nullptr, 0);
+    for (const ShaderAttribute& attribute : attributes)
     {
-        std::cout << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ" << std::endl;
+        signature = hashBytes64(&attribute.hash, sizeof(attribute.hash), signature);
+        signature = hashBytes64(&attribute.location, sizeof(attribute.location), signature);
+        signature = hashBytes64(&attribute.type, sizeof(attribute.type), signature);
     }
+}
 
-    // 2. 编译着色器
-    unsigned int vertexShader = createVertexShader(vertexCode);
-    unsigned int fragShader = createFragShader(fragmentCode);
+Shader::Shader(const char* vertexPath, const char* fragmentPath, const std::string& defines,
+    const std::vector<SpecializationConstant>& constants)
+    : defines(defines), constants(constants)
+{
+    readSource(vertexPath, fragmentPath);
+    compile();
+    link();
+    finishLink();
+}
+
+Shader::Shader(const EmbeddedFile& vertex, const EmbeddedFile& fragment, const std::string& defines,
+    const std::vector<SpecializationConstant>& constants)
+    : Shader(getEmbeddedPath(vertex).c_str(), getEmbeddedPath(fragment).c_str(), defines, constants)
+{
+}
+
+Shader::Shader(const char* vertexPath, const char* fragmentPath, const std::string& defines,
+    const std::vector<SpecializationConstant>& constants, Deferred)
+    : defines(defines), constants(constants)
+{
+    readSource(vertexPath, fragmentPath);
+}
+
+void Shader::readSource(const char* vertexPath, const char* fragmentPath)
+{
+    this->vertexPath = vertexPath;
+    this->fragmentPath = fragmentPath;
+    ShaderTelemetry& telemetry = ShaderTelemetry::instance();
+    telemetryId = telemetry.begin(this->vertexPath + " " + this->fragmentPath, defines + buildConstantDefines(constants));
+    requestTime = ShaderTelemetry::now();
+
+    // 1. 从文件路径中获取顶点/片段着色器，#include 在这里展开，未修改的文件直接使用缓存
+    ShaderPreprocessor& preprocessor = ShaderPreprocessor::instance();
+    const ShaderPreprocessor::Unit& vertexUnit = preprocessor.preprocess(this->vertexPath);
+    const ShaderPreprocessor::Unit& fragmentUnit = preprocessor.preprocess(this->fragmentPath);
+    // GLSL 没有特化常量，以宏的形式插入
+    std::string allDefines = defines + buildConstantDefines(constants);
+    // 离线优化过且没有过期时使用优化后的源码，两个阶段各自独立判断
+    // 离线结果是按不带宏的源码优化的，#ifdef 分支已经被裁掉，带宏的变体只能使用原始源码
+    std::string optimizedVertex;
+    std::string optimizedFragment;
+    bool vertexOptimized = allDefines.empty() && ShaderPreprocessor::readOptimized(vertexUnit, optimizedVertex);
+    bool fragmentOptimized = allDefines.empty() && ShaderPreprocessor::readOptimized(fragmentUnit, optimizedFragment);
+    vertexCode = ShaderPreprocessor::injectDefines(vertexOptimized ? optimizedVertex : vertexUnit.source, allDefines);
+    fragmentCode = ShaderPreprocessor::injectDefines(fragmentOptimized ? optimizedFragment : fragmentUnit.source, allDefines);
+    vertexHash = vertexUnit.hash;
+    fragmentHash = fragmentUnit.hash;
+    preprocessorRevision = preprocessor.getRevision();
+
+    // 两个阶段都有 SPIR-V 时才使用，源码仍然保留，用于计算缓存 key 和回退
+    // SPIR-V 同样不带宏，有 defines 时使用源码；常量通过 glSpecializeShader 设置，不受影响
+    if (glExtensions.spirv && defines.empty())
+    {
+        vertexSpirv = readSpirv((vertexOptimized ? ShaderPreprocessor::getOptimizedPath(this->vertexPath) : this->vertexPath) + ".spv");
+        fragmentSpirv = readSpirv((fragmentOptimized ? ShaderPreprocessor::getOptimizedPath(this->fragmentPath) : this->fragmentPath) + ".spv");
+        if (!vertexSpirv.isOpen() || !fragmentSpirv.isOpen())
+        {
+            vertexSpirv.close();
+            fragmentSpirv.close();
+        }
+    }
+    telemetry.get(telemetryId).readMs = ShaderTelemetry::now() - requestTime;
+}
+
+void Shader::compile()
+{
+    ShaderProgramStats& stats = ShaderTelemetry::instance().get(telemetryId);
+    // 2. 优先从 program 二进制缓存加载，命中时直接可用
+    ShaderCache& cache = ShaderCache::instance();
+    cacheKey = cache.makeKey(vertexCode, fragmentCode, defines + buildConstantDefines(constants));
+    double start = ShaderTelemetry::now();
+    shaderProgram = cache.load(cacheKey);
+    if (shaderProgram != 0)
+    {
+        stats.cacheHit = true;
+        stats.linkMs += ShaderTelemetry::now() - start;
+        onLinked();
+    }
+    else if (vertexSpirv.isOpen())
+    {
+        // SPIR-V 已经离线完成了解析和优化，驱动只需要特化和生成代码
+        start = ShaderTelemetry::now();
+        vertexShader = createSpirvShader(GL_VERTEX_SHADER, vertexSpirv);
+        stats.vertexCompileMs += ShaderTelemetry::now() - start;
+        start = ShaderTelemetry::now();
+        fragShader = createSpirvShader(GL_FRAGMENT_SHADER, fragmentSpirv);
+        stats.fragmentCompileMs += ShaderTelemetry::now() - start;
+        stats.spirv = true;
+        usingSpirv = true;
+    }
+    else
+    {
+        // 只提交编译，不查询 GL_COMPILE_STATUS，驱动可以在后台继续编译
+        start = ShaderTelemetry::now();
+        vertexShader = createVertexShader(vertexCode);
+        stats.vertexCompileMs += ShaderTelemetry::now() - start;
+        start = ShaderTelemetry::now();
+        fragShader = createFragShader(fragmentCode);
+        stats.fragmentCompileMs += ShaderTelemetry::now() - start;
+    }
+    // glShaderBinary 返回后驱动已经持有模块，映射可以立即释放（Windows 下不再占用 .spv 文件）
+    vertexSpirv.close();
+    fragmentSpirv.close();
+}
+
+void Shader::link()
+{
+    if (state != State::Compiling)
+    {
+        return;
+    }
+    // 同样只提交 link，状态等到第一次使用时再查询
+    double start = ShaderTelemetry::now();
     shaderProgram = createShaderProgram(vertexShader, fragShader);
+    ShaderTelemetry::instance().get(telemetryId).linkMs += ShaderTelemetry::now() - start;
+    state = State::Linking;
+}
+
+void Shader::finishLink()
+{
+    if (state != State::Linking)
+    {
+        return;
+    }
 
+    // 可省略，用于获取 shader 编译和 link 失败后的错误信息
+    // 查询状态会阻塞到驱动完成，阻塞的时间计入对应阶段
+    ShaderProgramStats& stats = ShaderTelemetry::instance().get(telemetryId);
+    double start = ShaderTelemetry::now();
+    checkCompileStatus(vertexShader, "VERTEX", stats.vertexLog);
+    stats.vertexCompileMs += ShaderTelemetry::now() - start;
+    start = ShaderTelemetry::now();
+    checkCompileStatus(fragShader, "FRAGMENT", stats.fragmentLog);
+    stats.fragmentCompileMs += ShaderTelemetry::now() - start;
+    start = ShaderTelemetry::now();
+    bool linked = checkLinkStatus(shaderProgram, stats.linkLog);
+    stats.linkMs += ShaderTelemetry::now() - start;
+
+    if (usingSpirv && (!linked || !hasReflectionNames(shaderProgram)))
+    {
+        fallbackToGLSL();
+        return;
+    }
+
+    // 删除 shader
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragShader);
+    vertexShader = 0;
+    fragShader = 0;
+
+    if (linked)
+    {
+        // 未命中缓存的 program 写回缓存
+        ShaderCache::instance().store(cacheKey, shaderProgram);
+        onLinked();
+    }
+    else
+    {
+        stats.readyMs = ShaderTelemetry::now() - requestTime;
+        state = State::Failed;
+    }
+
+    // 源码已经不再需要
+    vertexCode.clear();
+    vertexCode.shrink_to_fit();
+    fragmentCode.clear();
+    fragmentCode.shrink_to_fit();
+}
+
+void Shader::fallbackToGLSL()
+{
+    std::cout << "SHADER::SPIRV::FALLBACK_TO_GLSL " << vertexPath << " " << fragmentPath << std::endl;
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragShader);
+    GLState::instance().deleteProgram(shaderProgram);
+    vertexShader = 0;
+    fragShader = 0;
+    shaderProgram = 0;
+    usingSpirv = false;
+    ShaderProgramStats& stats = ShaderTelemetry::instance().get(telemetryId);
+    stats.spirv = false;
+    stats.spirvFallback = true;
+
+    // 已经在等待结果，直接同步编译
+    state = State::Compiling;
+    compile();
+    link();
+    finishLink();
+}
+
+void Shader::onLinked()
+{
+    // 每次 link 成功都分配新的编号，Uniform<T> 据此判断缓存的 location 是否过期
+    static unsigned int nextLinkStamp = 0;
+    linkStamp = ++nextLinkStamp;
+    // link 成功后一次性枚举 active uniform，之后 set* 不再查询驱动
+    uniforms.build(shaderProgram);
+    reflectShaderAttributes(shaderProgram, attributes, attributeSignature);
+    // PerFrame/PerMaterial/PerObject 等 uniform block 绑定到约定的绑定点
+    bindUniformBlockSlots(shaderProgram);
+    state = State::Ready;
+    ShaderProgramStats& stats = ShaderTelemetry::instance().get(telemetryId);
+    stats.linked = true;
+    stats.readyMs = ShaderTelemetry::now() - requestTime;
+}
+
+bool Shader::isReady()
+{
+    if (state == State::Linking)
+    {
+        // GL_COMPLETION_STATUS_KHR 不会等待驱动，编译和 link 都完成后才返回 GL_TRUE
+        // 不支持该扩展时无法得知驱动是否完成，交给 ShaderBatch::poll 或第一次 use 收尾
+        if (!glExtensions.parallelShaderCompile)
+        {
+            return false;
+        }
+        int completed = 0;
+        glGetProgramiv(shaderProgram, GL_COMPLETION_STATUS_KHR, &completed);
+        if (!completed)
+        {
+            return false;
+        }
+        finishLink();
+    }
+    return state == State::Ready;
+}
+
+void Shader::enableHotReload()
+{
+    watchSources();
+    hotReload = true;
+}
+
+void Shader::watchSources()
+{
+    // 监视整个 include 闭包，被 include 的文件修改也会触发重新编译
+    FileWatcher& watcher = FileWatcher::instance();
+    ShaderPreprocessor& preprocessor = ShaderPreprocessor::instance();
+    for (const std::string& file : preprocessor.preprocess(vertexPath).files)
+    {
+        if (!isEmbeddedPath(file))
+        {
+            watcher.watch(file);
+        }
+    }
+    for (const std::string& file : preprocessor.preprocess(fragmentPath).files)
+    {
+        if (!isEmbeddedPath(file))
+        {
+            watcher.watch(file);
+        }
+    }
+}
+
+bool Shader::update(bool canFinish)
+{
+    if (!hotReload)
+    {
+        return false;
+    }
+
+    bool finished = false;
+    if (reloading)
+    {
+        // 驱动还在后台编译时直接返回，下一帧再检查
+        if (!reloading->isReady() && !reloading->isFailed())
+        {
+            if (glExtensions.parallelShaderCompile || !canFinish)
+            {
+                return false;
+            }
+            reloading->finishLink();
+            finished = true;
+        }
+
+        // 无论成功与否都记录新的源码，避免对同一份错误的源码反复编译
+        vertexHash = reloading->vertexHash;
+        fragmentHash = reloading->fragmentHash;
+        watchSources();
+        if (reloading->state == State::Ready)
+        {
+            swapProgram(*reloading);
+            std::cout << "SHADER::RELOADED " << vertexPath << " " << fragmentPath << std::endl;
+        }
+        else
+        {
+            std::cout << "ERROR::SHADER::RELOAD_FAILED keep previous program" << std::endl;
+        }
+        reloading->release();
+        reloading.reset();
+        return finished;
+    }
+
+    // 没有任何 unit 失效时无需检查
+    ShaderPreprocessor& preprocessor = ShaderPreprocessor::instance();
+    preprocessor.refresh();
+    if (preprocessor.getRevision() == preprocessorRevision)
+    {
+        return false;
+    }
+    preprocessorRevision = preprocessor.getRevision();
+
+    // 只有自己的 include 闭包变化时才重新编译，完成之前继续使用旧的 program
+    if (preprocessor.preprocess(vertexPath).hash != vertexHash || preprocessor.preprocess(fragmentPath).hash != fragmentHash)
+    {
+        reloading.reset(new Shader(vertexPath.c_str(), fragmentPath.c_str(), defines, constants, Deferred()));
+        // 离线生成的 SPIR-V 对应的是修改之前的源码
+        reloading->vertexSpirv.close();
+        reloading->fragmentSpirv.close();
+        reloading->compile();
+        reloading->link();
+        // 与 ShaderBatch::poll 相同，本帧只提交，让驱动有一帧的时间编译，下一次 update 再收尾
+    }
+    return false;
+}
+
+void Shader::swapProgram(Shader& next)
+{
+    GLState& glState = GLState::instance();
+    unsigned int previous = shaderProgram;
+    // 从状态缓存中读取当前 program，不需要 glGetIntegerv 同步查询
+    unsigned int currentProgram = glState.getCurrentProgram();
+
+    // 把旧 program 中已经设置的 uniform 值和 uniform block 绑定点搬到新的 program
+    if (state == State::Ready)
+    {
+        copyProgramState(previous, next.shaderProgram);
+    }
+    // copyProgramState 会切换当前 program，之后恢复；旧 program 正在使用时换成新的
+    if (currentProgram == previous)
+    {
+        glState.useProgram(next.shaderProgram);
+    }
+    else if (state == State::Ready)
+    {
+        glState.useProgram(currentProgram != GLState::kUnknown ? currentProgram : 0);
+    }
+    glState.deleteProgram(previous);
+    // 旧的 program 可能还没有收尾
+    if (vertexShader != 0)
+    {
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragShader);
+        vertexShader = 0;
+        fragShader = 0;
+    }
+
+    shaderProgram = next.shaderProgram;
+    uniforms = std::move(next.uniforms);
+    attributes = std::move(next.attributes);
+    attributeSignature = next.attributeSignature;
+    linkStamp = next.linkStamp;
+    state = State::Ready;
+    next.shaderProgram = 0;
+    // 之后的统计（第一次使用）记到新 program 上
+    telemetryId = next.telemetryId;
+    usedOnce = false;
 }
 
 void Shader::release()
 {
-    glDeleteProgram(shaderProgram);
+    if (reloading)
+    {
+        reloading->release();
+        reloading.reset();
+    }
+    if (vertexShader != 0)
+    {
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragShader);
+    }
+    uniforms.clear();
+    GLState::instance().deleteProgram(shaderProgram);
 }
 
 void Shader::use()
 {
-    glUseProgram(shaderProgram);
+    // 第一次使用时记录阻塞的时间，异步编译还没完成时会在这里等待
+    double start = usedOnce ? 0.0 : ShaderTelemetry::now();
+    finishLink();
+    // 经过状态缓存，program 已经是当前 program 时不会再调用 glUseProgram
+    GLState::instance().useProgram(shaderProgram);
+    if (!usedOnce)
+    {
+        ShaderTelemetry::instance().get(telemetryId).firstUseMs = ShaderTelemetry::now() - start;
+        usedOnce = true;
+    }
 }
 
-void Shader::setBool(const std::string& name, bool value) const
+int Shader::getUniformLocation(HashedString name) const
 {
-    glUniform1i(glGetUniformLocation(shaderProgram, name.c_str()), (int)value);
+    return uniforms.find(name);
 }
 
-void Shader::setInt(const std::string& name, int value) const
+void Shader::setBool(HashedString name, bool value) const
 {
-    glUniform1i(glGetUniformLocation(shaderProgram, name.c_str()), (int)value);
+    glUniform1i(uniforms.find(name), (int)value);
 }
 
-void Shader::setFloat(const std::string& name, float value) const
+void Shader::setInt(HashedString name, int value) const
 {
-    glUniform1f(glGetUniformLocation(shaderProgram, name.c_str()), value);
+    glUniform1i(uniforms.find(name), (int)value);
+}
+
+void Shader::setFloat(HashedString name, float value) const
+{
+    glUniform1f(uniforms.find(name), value);
 }
 
 unsigned int Shader::createVertexShader(const std::string& vShaderCodes)
@@ -74,20 +637,11 @@ unsigned int Shader::createVertexShader(const std::string& vShaderCodes)
     vertexShader = glCreateShader(GL_VERTEX_SHADER);
 
     // 将 Shader 源码绑定到 shader 对象
-    glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
+    GLint vertexShaderLength = (GLint)vShaderCodes.size();
+    glShaderSource(vertexShader, 1, &vertexShaderSource, &vertexShaderLength);
     // 编译 shader
     glCompileShader(vertexShader);
 
-    // 可省略，用于获取 shader 编译失败后的错误信息
-    int  success; // GL_TRUE: 1, GL_FALSE: 0
-    char infoLog[512];
-    glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-    if (!success)
-    {
-        glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
-        std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
-    }
-
     return vertexShader;
 }
 
@@ -97,21 +651,34 @@ unsigned int Shader::createFragShader(const std::string& fShaderCode)
 
     unsigned int fragShader;
     fragShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragShader, 1, &fragShaderSource, NULL);
+    GLint fragShaderLength = (GLint)fShaderCode.size();
+    glShaderSource(fragShader, 1, &fragShaderSource, &fragShaderLength);
     // 编译 shader
     glCompileShader(fragShader);
 
-    // 可省略，用于获取 shader 编译失败后的错误信息
-    int  success; // GL_TRUE: 1, GL_FALSE: 0
-    char infoLog[512];
-    glGetShaderiv(fragShader, GL_COMPILE_STATUS, &success);
-    if (!success)
+    return fragShader;
+}
+
+unsigned int Shader::createSpirvShader(GLenum type, const MappedFile& spirv)
+{
+    unsigned int shader = glCreateShader(type);
+    glShaderBinary(1, &shader, GL_SHADER_BINARY_FORMAT_SPIR_V, spirv.data(), (GLsizei)spirv.size());
+
+    // 只传入模块中存在的特化常量，其余的保持模块中的默认值
+    std::vector<unsigned int> moduleIds = getSpecializationIds(spirv.data(), spirv.size());
+    std::vector<unsigned int> ids;
+    std::vector<unsigned int> values;
+    for (const SpecializationConstant& constant : constants)
     {
-        glGetShaderInfoLog(fragShader, 512, NULL, infoLog);
-        std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
+        if (std::find(moduleIds.begin(), moduleIds.end(), constant.id) != moduleIds.end())
+        {
+            ids.push_back(constant.id);
+            values.push_back((unsigned int)constant.value);
+        }
     }
-
-    return fragShader;
+    // 特化的结果同样通过 GL_COMPILE_STATUS 查询
+    glSpecializeShader(shader, "main", (GLuint)ids.size(), ids.data(), values.data());
+    return shader;
 }
 
 unsigned int Shader::createShaderProgram(unsigned int vertexShader, unsigned int fragShader)
@@ -119,23 +686,39 @@ unsigned int Shader::createShaderProgram(unsigned int vertexShader, unsigned int
     // 创建 shader program
     unsigned int shaderProgram;
     shaderProgram = glCreateProgram();
+    // 告诉驱动之后会读取 program 二进制，用于写入磁盘缓存
+    if (glExtensions.programBinary)
+    {
+        glProgramParameteri(shaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
     // attach 并 link 2 个 shader
     glAttachShader(shaderProgram, vertexShader);
     glAttachShader(shaderProgram, fragShader);
     glLinkProgram(shaderProgram);
 
-    // 可省略，用于获取 shader program link 失败后的错误信息
+    return shaderProgram;
+}
+
+bool Shader::checkCompileStatus(unsigned int shader, const char* stage, std::string& log)
+{
     int  success; // GL_TRUE: 1, GL_FALSE: 0
-    char infoLog[512];
-    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-    if (!success) {
-        glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
-        std::cout << "ERROR::PROGRAM::LINK_FAILED\n" << infoLog << std::endl;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    // 成功时也可能有警告，一并保留
+    log = getShaderInfoLog(shader);
+    if (!success)
+    {
+        std::cout << "ERROR::SHADER::" << stage << "::COMPILATION_FAILED\n" << log << std::endl;
     }
+    return success != 0;
+}
 
-    // 删除 shader
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragShader);
-
-    return shaderProgram;
+bool Shader::checkLinkStatus(unsigned int program, std::string& log)
+{
+    int  success; // GL_TRUE: 1, GL_FALSE: 0
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    log = getProgramInfoLog(program);
+    if (!success) {
+        std::cout << "ERROR::PROGRAM::LINK_FAILED\n" << log << std::endl;
+    }
+    return success != 0;
 }
@@ -0,0 +1,67 @@
+#include "ShaderBatch.h"
+#include "GLExtensions.h"
+
+ShaderBatch::ShaderBatch()
+{
+    // 0xFFFFFFFF 表示由驱动决定编译线程数
+    if (glExtensions.parallelShaderCompile)
+    {
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+    }
+}
+
+Shader* ShaderBatch::add(const char* vertexPath, const char* fragmentPath, const std::string& defines,
+    const std::vector<SpecializationConstant>& constants)
+{
+    shaders.emplace_back(new Shader(vertexPath, fragmentPath, defines, constants, Shader::Deferred()));
+    return shaders.back().get();
+}
+
+void ShaderBatch::submit()
+{
+    // 先提交全部编译，再提交全部 link，避免 link 等待还没开始编译的 shader
+    for (size_t i = submitted; i < shaders.size(); ++i)
+    {
+        shaders[i]->compile();
+    }
+    for (size_t i = submitted; i < shaders.size(); ++i)
+    {
+        shaders[i]->link();
+    }
+    submitted = shaders.size();
+}
+
+size_t ShaderBatch::poll()
+{
+    // 没有 KHR_parallel_shader_compile 时无法非阻塞地查询，每次只收尾一个 program，把等待分摊到多帧
+    bool canFinish = !glExtensions.parallelShaderCompile;
+    size_t pending = 0;
+    for (size_t i = 0; i < submitted; ++i)
+    {
+        Shader& shader = *shaders[i];
+        if (shader.state != Shader::State::Linking)
+        {
+            continue;
+        }
+        if (canFinish)
+        {
+            shader.finishLink();
+            canFinish = false;
+        }
+        else if (!shader.isReady())
+        {
+            ++pending;
+        }
+    }
+    return pending;
+}
+
+void ShaderBatch::release()
+{
+    for (auto& shader : shaders)
+    {
+        shader->release();
+    }
+    shaders.clear();
+    submitted = 0;
+}
@@ -0,0 +1,176 @@
+#include "ShaderCache.h"
+#include "GLExtensions.h"
+#include "MappedFile.h"
+#include "StringHash.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace
+{
+    // 缓存文件头，magic 或 version 不匹配的文件视为无效
+    struct CacheFileHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t key;
+        uint32_t binaryFormat;
+        uint32_t binaryLength;
+    };
+
+    const uint32_t kCacheMagic = 0x42504C47; // "GLPB"
+    const uint32_t kCacheVersion = 1;
+
+    const char* getGLString(GLenum name)
+    {
+        const char* value = (const char*)glGetString(name);
+        return value != NULL ? value : "";
+    }
+}
+
+ShaderCache& ShaderCache::instance()
+{
+    static ShaderCache cache;
+    return cache;
+}
+
+void ShaderCache::setDirectory(const std::string& directory)
+{
+    this->directory = directory;
+    directoryCreated = false;
+}
+
+bool ShaderCache::isEnabled() const
+{
+    return glExtensions.programBinary && !directory.empty();
+}
+
+uint64_t ShaderCache::makeKey(const std::string& vertexCode, const std::string& fragmentCode, const std::string& defines)
+{
+    // 驱动信息只需查询一次，驱动升级后 key 随之变化，旧的缓存自动失效
+    if (driverInfo.empty())
+    {
+        driverInfo = std::string(getGLString(GL_VENDOR)) + "|" + getGLString(GL_RENDERER) + "|"
+            + getGLString(GL_VERSION) + "|" + getGLString(GL_SHADING_LANGUAGE_VERSION);
+    }
+
+    // 每段之间混入长度，避免 "ab" + "c" 与 "a" + "bc" 得到相同的 key
+    uint64_t key = hashBytes64(driverInfo.data(), driverInfo.size());
+    const std::string* parts[] = { &defines, &vertexCode, &fragmentCode };
+    for (const std::string* part : parts)
+    {
+        uint64_t length = part->size();
+        key = hashBytes64(&length, sizeof(length), key);
+        key = hashBytes64(part->data(), part->size(), key);
+    }
+    return key;
+}
+
+unsigned int ShaderCache::load(uint64_t key, bool separable)
+{
+    if (!isEnabled())
+    {
+        return 0;
+    }
+
+    // 映射缓存文件，二进制部分不经过中间缓冲直接交给 glProgramBinary
+    std::string path = getPath(key);
+    MappedFile file;
+    CacheFileHeader header = {};
+    if (!file.open(path, false) || file.size() < sizeof(header))
+    {
+        ++misses;
+        return 0;
+    }
+    memcpy(&header, file.data(), sizeof(header));
+    if (header.magic != kCacheMagic || header.version != kCacheVersion || header.key != key
+        || file.size() - sizeof(header) < header.binaryLength)
+    {
+        ++misses;
+        return 0;
+    }
+
+    unsigned int program = glCreateProgram();
+    if (separable)
+    {
+        glProgramParameteri(program, GL_PROGRAM_SEPARABLE, GL_TRUE);
+    }
+    glProgramBinary(program, header.binaryFormat, file.data() + sizeof(header), (GLsizei)header.binaryLength);
+    // 驱动在 glProgramBinary 返回前已经读取完数据；Windows 下映射中的文件无法删除，需要先关闭
+    file.close();
+
+    // 驱动可以拒绝任何二进制（格式变化、文件损坏等），此时删除缓存并回退到源码编译
+    int success = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        glDeleteProgram(program);
+        std::remove(path.c_str());
+        ++rejected;
+        ++misses;
+        return 0;
+    }
+
+    ++hits;
+    return program;
+}
+
+void ShaderCache::store(uint64_t key, unsigned int program)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+
+    int length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+    {
+        return;
+    }
+
+    std::vector<char> binary(length);
+    GLenum binaryFormat = 0;
+    glGetProgramBinary(program, length, &length, &binaryFormat, binary.data());
+
+    if (!directoryCreated)
+    {
+#ifdef _WIN32
+        _mkdir(directory.c_str());
+#else
+        mkdir(directory.c_str(), 0755);
+#endif
+        directoryCreated = true;
+    }
+
+    std::ofstream file(getPath(key), std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        std::cout << "ERROR::SHADER::CACHE::WRITE_FAILED\n" << getPath(key) << std::endl;
+        return;
+    }
+    CacheFileHeader header = { kCacheMagic, kCacheVersion, key, binaryFormat, (uint32_t)length };
+    file.write((const char*)&header, sizeof(header));
+    file.write(binary.data(), length);
+    ++stores;
+}
+
+void ShaderCache::printStats() const
+{
+    std::cout << "SHADER::CACHE hits: " << hits << " misses: " << misses
+        << " rejected: " << rejected << " stored: " << stores << std::endl;
+}
+
+std::string ShaderCache::getPath(uint64_t key) const
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+    return directory + "/" + name;
+}
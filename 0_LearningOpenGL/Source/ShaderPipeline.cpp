@@ -0,0 +1,306 @@
+#include "ShaderPipeline.h"
+#include "GLExtensions.h"
+#include "GLState.h"
+#include <algorithm>
+#include <iostream>
+
+bool ShaderPipeline::isReady()
+{
+    if (shader != nullptr)
+    {
+        return shader->isReady();
+    }
+    if (pipeline == 0)
+    {
+        if (!vertex->isReady() || !fragment->isReady())
+        {
+            return false;
+        }
+        createPipeline();
+    }
+    return true;
+}
+
+bool ShaderPipeline::isFailed() const
+{
+    if (shader != nullptr)
+    {
+        return shader->isFailed();
+    }
+    return vertex->isFailed() || fragment->isFailed();
+}
+
+void ShaderPipeline::use()
+{
+    if (shader != nullptr)
+    {
+        shader->use();
+        return;
+    }
+    if (pipeline == 0)
+    {
+        vertex->finishLink();
+        fragment->finishLink();
+        createPipeline();
+    }
+    GLState::instance().bindProgramPipeline(pipeline);
+}
+
+void ShaderPipeline::createPipeline()
+{
+    glGenProgramPipelines(1, &pipeline);
+    glUseProgramStages(pipeline, vertex->getStageBit(), vertex->getProgram());
+    glUseProgramStages(pipeline, fragment->getStageBit(), fragment->getProgram());
+
+    // 两个阶段的输入输出是否匹配只有组合之后才知道，只在创建时检查一次
+    int success = 0;
+    glValidateProgramPipeline(pipeline);
+    glGetProgramPipelineiv(pipeline, GL_VALIDATE_STATUS, &success);
+    if (!success)
+    {
+        int length = 0;
+        glGetProgramPipelineiv(pipeline, GL_INFO_LOG_LENGTH, &length);
+        std::string infoLog(length > 0 ? length : 1, '\0');
+        glGetProgramPipelineInfoLog(pipeline, (GLsizei)infoLog.size(), &length, &infoLog[0]);
+        infoLog.resize(length);
+        std::cout << "ERROR::PROGRAM::PIPELINE::VALIDATE_FAILED " << vertex->getPath() << " "
+            << fragment->getPath() << "\n" << infoLog << std::endl;
+    }
+}
+
+void ShaderPipeline::setBool(HashedString name, bool value) const
+{
+    setInt(name, (int)value);
+}
+
+void ShaderPipeline::setInt(HashedString name, int value) const
+{
+    if (shader != nullptr)
+    {
+        shader->setInt(name, value);
+        return;
+    }
+    // 同名 uniform 可能同时出现在两个阶段中
+    const ShaderStage* pipelineStages[] = { vertex, fragment };
+    for (const ShaderStage* stage : pipelineStages)
+    {
+        int location = stage->getUniformLocation(name);
+        if (location >= 0)
+        {
+            glProgramUniform1i(stage->getProgram(), location, value);
+        }
+    }
+}
+
+void ShaderPipeline::setFloat(HashedString name, float value) const
+{
+    if (shader != nullptr)
+    {
+        shader->setFloat(name, value);
+        return;
+    }
+    const ShaderStage* pipelineStages[] = { vertex, fragment };
+    for (const ShaderStage* stage : pipelineStages)
+    {
+        int location = stage->getUniformLocation(name);
+        if (location >= 0)
+        {
+            glProgramUniform1f(stage->getProgram(), location, value);
+        }
+    }
+}
+
+unsigned int ShaderPipeline::getProgram(GLenum type) const
+{
+    if (shader != nullptr)
+    {
+        return shader->shaderProgram;
+    }
+    return type == GL_VERTEX_SHADER ? vertex->getProgram() : fragment->getProgram();
+}
+
+const std::vector<ShaderAttribute>& ShaderPipeline::getAttributes() const
+{
+    return shader != nullptr ? shader->getAttributes() : vertex->getAttributes();
+}
+
+uint64_t ShaderPipeline::getAttributeSignature() const
+{
+    return shader != nullptr ? shader->getAttributeSignature() : vertex->getAttributeSignature();
+}
+
+ShaderPipelineCache& ShaderPipelineCache::instance()
+{
+    static ShaderPipelineCache cache;
+    return cache;
+}
+
+uint64_t ShaderPipelineCache::hashParts(const std::string* parts, int count, uint64_t seed)
+{
+    // 每段之间混入长度，避免不同的拆分得到相同的 key
+    uint64_t key = seed;
+    for (int i = 0; i < count; ++i)
+    {
+        uint64_t length = parts[i].size();
+        key = hashBytes64(&length, sizeof(length), key);
+        key = hashBytes64(parts[i].data(), parts[i].size(), key);
+    }
+    return key;
+}
+
+size_t ShaderPipelineCache::KeyHash::operator()(const StageKey& key) const
+{
+    const std::string parts[] = { key.path, key.defines };
+    return (size_t)hashParts(parts, 2, hashBytes64(&key.type, sizeof(key.type)));
+}
+
+size_t ShaderPipelineCache::KeyHash::operator()(const PipelineKey& key) const
+{
+    const std::string parts[] = { key.vertexPath, key.vertexDefines, key.fragmentPath, key.fragmentDefines };
+    return (size_t)hashParts(parts, 4, hashBytes64(nullptr, 0));
+}
+
+ShaderStage& ShaderPipelineCache::getStage(GLenum type, const char* path, const std::string& defines)
+{
+    StageKey key = { type, path, defines };
+    auto it = stages.find(key);
+    if (it == stages.end())
+    {
+        it = stages.emplace(std::move(key), std::unique_ptr<ShaderStage>(new ShaderStage(type, path, defines))).first;
+    }
+    return *it->second;
+}
+
+std::string ShaderPipelineCache::mergeDefines(const std::string& vertexDefines, const std::string& fragmentDefines)
+{
+    // 每行为一条指令，#define 按宏名去重，其他行按整行去重
+    std::vector<std::pair<std::string, std::string>> lines;
+    const std::string* sources[] = { &vertexDefines, &fragmentDefines };
+    for (const std::string* source : sources)
+    {
+        size_t start = 0;
+        while (start < source->size())
+        {
+            size_t end = source->find('\n', start);
+            if (end == std::string::npos)
+            {
+                end = source->size();
+            }
+            std::string line = source->substr(start, end - start);
+            start = end + 1;
+
+            std::string name;
+            size_t directive = line.find_first_not_of(" \t");
+            if (directive != std::string::npos && line.compare(directive, 7, "#define") == 0)
+            {
+                size_t nameStart = line.find_first_not_of(" \t", directive + 7);
+                size_t nameEnd = nameStart == std::string::npos ? std::string::npos : line.find_first_of(" \t(", nameStart);
+                name = nameStart == std::string::npos ? "" : line.substr(nameStart, nameEnd - nameStart);
+            }
+            auto same = std::find_if(lines.begin(), lines.end(), [&](const std::pair<std::string, std::string>& existing)
+            {
+                return name.empty() ? existing.second == line : existing.first == name;
+            });
+            if (same == lines.end())
+            {
+                lines.emplace_back(name, line);
+            }
+            else if (same->second != line)
+            {
+                // 同一个 program 中宏只能有一个值，保留顶点阶段的定义
+                std::cout << "ERROR::PROGRAM::PIPELINE::CONFLICTING_DEFINE " << name << "\n"
+                    << same->second << "\n" << line << std::endl;
+            }
+        }
+    }
+
+    std::string defines;
+    for (const auto& line : lines)
+    {
+        defines += line.second;
+        defines += "\n";
+    }
+    return defines;
+}
+
+ShaderPipeline& ShaderPipelineCache::get(const char* vertexPath, const char* fragmentPath,
+    const std::string& vertexDefines, const std::string& fragmentDefines)
+{
+    PipelineKey key = { vertexPath, vertexDefines, fragmentPath, fragmentDefines };
+    auto it = pipelines.find(key);
+    if (it != pipelines.end())
+    {
+        return *it->second;
+    }
+
+    std::unique_ptr<ShaderPipeline> pipeline(new ShaderPipeline());
+    if (glExtensions.separateShaderObjects)
+    {
+        pipeline->vertex = &getStage(GL_VERTEX_SHADER, vertexPath, vertexDefines);
+        pipeline->fragment = &getStage(GL_FRAGMENT_SHADER, fragmentPath, fragmentDefines);
+    }
+    else
+    {
+        // 普通 program 只有一份宏定义，两个阶段的宏合并后同时插入
+        if (!batch)
+        {
+            batch.reset(new ShaderBatch());
+        }
+        std::string defines = vertexDefines == fragmentDefines ? vertexDefines : mergeDefines(vertexDefines, fragmentDefines);
+        pipeline->shader = batch->add(vertexPath, fragmentPath, defines);
+        batch->submit();
+    }
+    return *pipelines.emplace(std::move(key), std::move(pipeline)).first->second;
+}
+
+void ShaderPipelineCache::update()
+{
+    if (batch)
+    {
+        batch->poll();
+    }
+    // 没有 KHR_parallel_shader_compile 时 ShaderStage::isReady 不会主动完成，
+    // 与 ShaderBatch::poll 相同，每帧收尾一个阶段，把等待分摊到多帧
+    if (glExtensions.parallelShaderCompile)
+    {
+        return;
+    }
+    for (auto& stage : stages)
+    {
+        if (stage.second->state == ShaderStage::State::Linking)
+        {
+            stage.second->finishLink();
+            break;
+        }
+    }
+}
+
+void ShaderPipelineCache::release()
+{
+    GLState& glState = GLState::instance();
+    for (auto& pipeline : pipelines)
+    {
+        if (pipeline.second->pipeline != 0)
+        {
+            glState.deleteProgramPipeline(pipeline.second->pipeline);
+        }
+    }
+    pipelines.clear();
+    for (auto& stage : stages)
+    {
+        stage.second->release();
+    }
+    stages.clear();
+    if (batch)
+    {
+        batch->release();
+        batch.reset();
+    }
+}
+
+void ShaderPipelineCache::printStats() const
+{
+    // separable 时 stages 即编译次数，回退路径下每个 pipeline 都是一次 link
+    std::cout << "SHADER::PIPELINE stages: " << stages.size() << " pipelines: " << pipelines.size()
+        << " separable: " << (glExtensions.separateShaderObjects ? "yes" : "no") << std::endl;
+}
@@ -0,0 +1,376 @@
+#include "ShaderPreprocessor.h"
+#include "EmbeddedFiles.h"
+#include "MappedFile.h"
+#include "FileWatcher.h"
+#include "StringHash.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+ShaderPreprocessor& ShaderPreprocessor::instance()
+{
+    static ShaderPreprocessor preprocessor;
+    return preprocessor;
+}
+
+const ShaderPreprocessor::Unit& ShaderPreprocessor::preprocess(const std::string& path)
+{
+    auto it = units.find(path);
+    if (it != units.end())
+    {
+        return it->second;
+    }
+
+    Unit& unit = units[path];
+    std::vector<std::string> stack;
+    std::unordered_set<std::string> onceFiles;
+    expand(path, unit, stack, onceFiles);
+    unit.hash = hashBytes64(unit.source.data(), unit.source.size());
+    return unit;
+}
+
+void ShaderPreprocessor::refresh()
+{
+    FileWatcher& watcher = FileWatcher::instance();
+    unsigned int generation = watcher.getGeneration();
+    if (generation == watcherGeneration)
+    {
+        return;
+    }
+    watcherGeneration = generation;
+
+    // 重新读取时可能发现新的 include 并插入 files，所以先收集再处理
+    std::vector<std::string> changed;
+    for (auto& entry : files)
+    {
+        unsigned int version = watcher.getVersion(entry.first);
+        if (version != entry.second.version)
+        {
+            entry.second.version = version;
+            changed.push_back(entry.first);
+        }
+    }
+
+    for (const std::string& path : changed)
+    {
+        // 只有内容真的变化时才让依赖它的 unit 失效（例如只是保存了一次）
+        SourceFile& file = files[path];
+        uint64_t previousHash = file.hash;
+        readFile(path, file);
+        if (file.hash != previousHash)
+        {
+            invalidateDependents(path);
+        }
+    }
+}
+
+ShaderPreprocessor::SourceFile& ShaderPreprocessor::getFile(const std::string& path)
+{
+    auto it = files.find(path);
+    if (it != files.end())
+    {
+        return it->second;
+    }
+    SourceFile& file = files[path];
+    file.version = FileWatcher::instance().getVersion(path);
+    readFile(path, file);
+    return file;
+}
+
+void ShaderPreprocessor::readFile(const std::string& path, SourceFile& file)
+{
+    // 映射后只拷贝一次到缓存中，之后立即解除映射，编辑器可以继续保存文件
+    // 嵌入的文件同样经过 MappedFile，不访问文件系统
+    MappedFile mapping;
+    if (mapping.open(path, false))
+    {
+        mapping.copyTo(file.content, true);
+    }
+    else
+    {
+        std::cout << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ " << path << std::endl;
+        file.content.clear();
+    }
+    updateIncludes(path, file);
+}
+
+void ShaderPreprocessor::updateIncludes(const std::string& path, SourceFile& file)
+{
+    file.hash = hashBytes64(file.content.data(), file.content.size());
+
+    // 更新依赖图：先移除旧的反向边，再按新内容建立
+    for (const std::string& include : file.includes)
+    {
+        auto child = files.find(include);
+        if (child != files.end())
+        {
+            child->second.includedBy.erase(path);
+        }
+    }
+    file.includes.clear();
+    file.pragmaOnce = false;
+
+    std::istringstream lines(file.content);
+    std::string line;
+    std::string includePath;
+    while (std::getline(lines, line))
+    {
+        if (parseInclude(line, path, includePath))
+        {
+            file.includes.push_back(includePath);
+        }
+        else if (isPragmaOnce(line))
+        {
+            file.pragmaOnce = true;
+        }
+    }
+    for (const std::string& include : file.includes)
+    {
+        getFile(include).includedBy.insert(path);
+    }
+}
+
+void ShaderPreprocessor::expand(const std::string& path, Unit& unit, std::vector<std::string>& stack, std::unordered_set<std::string>& onceFiles)
+{
+    // 带 #pragma once 的文件已经展开过则跳过，这也允许互相 include
+    if (onceFiles.count(path) != 0)
+    {
+        return;
+    }
+    if (std::find(stack.begin(), stack.end(), path) != stack.end())
+    {
+        std::cout << "ERROR::SHADER::INCLUDE_CYCLE " << path << std::endl;
+        return;
+    }
+
+    // unordered_map 插入新元素时不会使已有元素的引用失效
+    const SourceFile& file = getFile(path);
+    if (file.pragmaOnce)
+    {
+        onceFiles.insert(path);
+    }
+
+    size_t fileIndex = std::find(unit.files.begin(), unit.files.end(), path) - unit.files.begin();
+    if (fileIndex == unit.files.size())
+    {
+        unit.files.push_back(path);
+    }
+    // #line 让编译错误的行号对应到被 include 的文件，根文件第一行是 #version，不能插入
+    if (!stack.empty())
+    {
+        unit.source += "#line 1 " + std::to_string(fileIndex) + "\n";
+    }
+
+    stack.push_back(path);
+    std::istringstream lines(file.content);
+    std::string line;
+    std::string includePath;
+    int lineNumber = 0;
+    while (std::getline(lines, line))
+    {
+        ++lineNumber;
+        if (parseInclude(line, path, includePath))
+        {
+            expand(includePath, unit, stack, onceFiles);
+            unit.source += "#line " + std::to_string(lineNumber + 1) + " " + std::to_string(fileIndex) + "\n";
+        }
+        else if (isPragmaOnce(line))
+        {
+            unit.source += "\n";
+        }
+        else
+        {
+            unit.source += line;
+            unit.source += "\n";
+        }
+    }
+    stack.pop_back();
+}
+
+std::string ShaderPreprocessor::injectDefines(const std::string& source, const std::string& defines)
+{
+    if (defines.empty())
+    {
+        return source;
+    }
+
+    // #version 必须是第一条指令，宏定义只能放在它后面
+    size_t start = source.find_first_not_of(" \t\r\n");
+    if (start == std::string::npos || source.compare(start, 8, "#version") != 0)
+    {
+        return defines + (defines.back() != '\n' ? "\n" : "") + "#line 1 0\n" + source;
+    }
+    size_t lineEnd = source.find('\n', start);
+    if (lineEnd == std::string::npos)
+    {
+        return source + "\n" + defines;
+    }
+    int versionLine = (int)std::count(source.begin(), source.begin() + lineEnd, '\n') + 1;
+    std::string result;
+    result.reserve(source.size() + defines.size() + 16);
+    result.append(source, 0, lineEnd + 1);
+    result += defines;
+    if (defines.back() != '\n')
+    {
+        result += '\n';
+    }
+    result += "#line " + std::to_string(versionLine + 1) + " 0\n";
+    result.append(source, lineEnd + 1, std::string::npos);
+    return result;
+}
+
+void ShaderPreprocessor::invalidateDependents(const std::string& path)
+{
+    // 沿反向边找出所有直接或间接 include 了该文件的文件，它们作为根的 unit 都需要重新展开
+    std::vector<std::string> pending = { path };
+    std::unordered_set<std::string> visited = { path };
+    while (!pending.empty())
+    {
+        std::string current = pending.back();
+        pending.pop_back();
+        units.erase(current);
+
+        for (const std::string& parent : files[current].includedBy)
+        {
+            if (visited.insert(parent).second)
+            {
+                pending.push_back(parent);
+            }
+        }
+    }
+    ++revision;
+}
+
+bool ShaderPreprocessor::parseInclude(const std::string& line, const std::string& from, std::string& includePath)
+{
+    size_t start = line.find_first_not_of(" \t");
+    if (start == std::string::npos || line.compare(start, 8, "#include") != 0)
+    {
+        return false;
+    }
+    size_t open = line.find('"', start + 8);
+    size_t close = open == std::string::npos ? std::string::npos : line.find('"', open + 1);
+    if (close == std::string::npos)
+    {
+        std::cout << "ERROR::SHADER::INVALID_INCLUDE " << from << "\n" << line << std::endl;
+        return false;
+    }
+
+    // 路径相对于当前文件所在的目录
+    size_t slash = from.find_last_of("/\\");
+    std::string directory = slash == std::string::npos ? "" : from.substr(0, slash + 1);
+    includePath = normalizePath(directory + line.substr(open + 1, close - open - 1));
+    return true;
+}
+
+bool ShaderPreprocessor::isPragmaOnce(const std::string& line)
+{
+    // 与 CompileSpirv.py 的 ^\s*#\s*pragma\s+once\b 相同，注释中出现的 "#pragma once" 不算
+    size_t position = line.find_first_not_of(" \t");
+    if (position == std::string::npos || line[position] != '#')
+    {
+        return false;
+    }
+    position = line.find_first_not_of(" \t", position + 1);
+    if (position == std::string::npos || line.compare(position, 6, "pragma") != 0)
+    {
+        return false;
+    }
+    position += 6;
+    size_t once = line.find_first_not_of(" \t", position);
+    if (once == position || once == std::string::npos || line.compare(once, 4, "once") != 0)
+    {
+        return false;
+    }
+    once += 4;
+    return once == line.size() || !(isalnum((unsigned char)line[once]) || line[once] == '_');
+}
+
+std::string ShaderPreprocessor::normalizePath(const std::string& path)
+{
+    // 嵌入路径的前缀不参与规范化，".." 不能越过它
+    size_t prefixLength = isEmbeddedPath(path) ? strlen(EMBEDDED_PATH_PREFIX) : 0;
+    bool absolute = path.size() > prefixLength && (path[prefixLength] == '/' || path[prefixLength] == '\\');
+    std::vector<std::string> parts;
+    size_t start = prefixLength;
+    while (start <= path.size())
+    {
+        size_t end = path.find_first_of("/\\", start);
+        if (end == std::string::npos)
+        {
+            end = path.size();
+        }
+        std::string part = path.substr(start, end - start);
+        if (part == "..")
+        {
+            // 相对路径开头的 ".." 无法抵消，保留；绝对路径的根目录之上没有目录，丢弃
+            if (!parts.empty() && parts.back() != "..")
+            {
+                parts.pop_back();
+            }
+            else if (!absolute)
+            {
+                parts.push_back(part);
+            }
+        }
+        else if (!part.empty() && part != ".")
+        {
+            parts.push_back(part);
+        }
+        start = end + 1;
+    }
+
+    std::string result = path.substr(0, prefixLength);
+    if (absolute)
+    {
+        result += '/';
+    }
+    for (size_t i = 0; i < parts.size(); ++i)
+    {
+        if (i > 0)
+        {
+            result += '/';
+        }
+        result += parts[i];
+    }
+    // 与 normpath 相同，空路径规范化为 "."
+    if (parts.empty() && !absolute)
+    {
+        result += '.';
+    }
+    return result;
+}
+
+std::string ShaderPreprocessor::getOptimizedPath(const std::string& path)
+{
+    size_t slash = path.find_last_of("/\\");
+    if (slash == std::string::npos)
+    {
+        return "Optimized/" + path;
+    }
+    return path.substr(0, slash + 1) + "Optimized/" + path.substr(slash + 1);
+}
+
+bool ShaderPreprocessor::readOptimized(const Unit& unit, std::string& source)
+{
+    MappedFile mapping;
+    if (!mapping.open(getOptimizedPath(unit.files.front()), false))
+    {
+        return false;
+    }
+
+    // 第一行是 #version，第二行是 "// source-hash: <16 位十六进制>"，在映射的内存上直接比较，过期时不拷贝
+    char expected[40];
+    int expectedLength = snprintf(expected, sizeof(expected), "// source-hash: %016llx", (unsigned long long)unit.hash);
+    const char* lineEnd = static_cast<const char*>(memchr(mapping.data(), '\n', mapping.size()));
+    size_t lineStart = lineEnd != nullptr ? lineEnd - mapping.data() + 1 : mapping.size();
+    if (mapping.size() - lineStart < (size_t)expectedLength || memcmp(mapping.data() + lineStart, expected, expectedLength) != 0)
+    {
+        return false;
+    }
+    mapping.copyTo(source, true);
+    return true;
+}
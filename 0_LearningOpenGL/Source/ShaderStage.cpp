@@ -0,0 +1,170 @@
+#include "ShaderStage.h"
+#include "GLExtensions.h"
+#include "GLState.h"
+#include "ShaderCache.h"
+#include "ShaderPreprocessor.h"
+#include "ShaderTelemetry.h"
+#include "UniformBuffer.h"
+#include <iostream>
+
+ShaderStage::ShaderStage(GLenum type, const char* path, const std::string& defines)
+    : type(type), path(path)
+{
+    ShaderTelemetry& telemetry = ShaderTelemetry::instance();
+    telemetryId = telemetry.begin(this->path, defines);
+    requestTime = ShaderTelemetry::now();
+
+    const ShaderPreprocessor::Unit& unit = ShaderPreprocessor::instance().preprocess(this->path);
+    std::string optimized;
+    // 离线优化的结果不带宏，只有不带 defines 的变体可以使用
+    bool useOptimized = defines.empty() && ShaderPreprocessor::readOptimized(unit, optimized);
+    std::string code = ShaderPreprocessor::injectDefines(useOptimized ? optimized : unit.source, buildPrologue(type, defines));
+    ShaderProgramStats& stats = telemetry.get(telemetryId);
+    stats.readMs = ShaderTelemetry::now() - requestTime;
+
+    // 另一个阶段的源码留空作为 key，不会与同时包含两个阶段的普通 program 冲突
+    ShaderCache& cache = ShaderCache::instance();
+    cacheKey = type == GL_VERTEX_SHADER ? cache.makeKey(code, "", defines) : cache.makeKey("", code, defines);
+    double start = ShaderTelemetry::now();
+    program = cache.load(cacheKey, true);
+    if (program != 0)
+    {
+        stats.cacheHit = true;
+        stats.linkMs = ShaderTelemetry::now() - start;
+        onLinked();
+        return;
+    }
+
+    double& compileMs = type == GL_VERTEX_SHADER ? stats.vertexCompileMs : stats.fragmentCompileMs;
+    start = ShaderTelemetry::now();
+    const char* source = code.c_str();
+    GLint sourceLength = (GLint)code.size();
+    shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, &sourceLength);
+    glCompileShader(shader);
+    compileMs = ShaderTelemetry::now() - start;
+    start = ShaderTelemetry::now();
+
+    program = glCreateProgram();
+    // 必须在 link 之前设置，否则 program 不能用于 pipeline
+    glProgramParameteri(program, GL_PROGRAM_SEPARABLE, GL_TRUE);
+    if (glExtensions.programBinary)
+    {
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    glAttachShader(program, shader);
+    glLinkProgram(program);
+    stats.linkMs = ShaderTelemetry::now() - start;
+}
+
+std::string ShaderStage::buildPrologue(GLenum type, const std::string& defines)
+{
+    // separable 的顶点阶段需要重新声明 gl_PerVertex，否则部分驱动拒绝与其他 program 组合
+    std::string prologue = "#extension GL_ARB_separate_shader_objects : enable\n";
+    if (type == GL_VERTEX_SHADER)
+    {
+        prologue += "out gl_PerVertex { vec4 gl_Position; float gl_PointSize; };\n";
+    }
+    return prologue + defines;
+}
+
+void ShaderStage::finishLink()
+{
+    if (state != State::Linking || shader == 0)
+    {
+        return;
+    }
+
+    ShaderProgramStats& stats = ShaderTelemetry::instance().get(telemetryId);
+    std::string& compileLog = type == GL_VERTEX_SHADER ? stats.vertexLog : stats.fragmentLog;
+    double& compileMs = type == GL_VERTEX_SHADER ? stats.vertexCompileMs : stats.fragmentCompileMs;
+    int success = 0;
+    double start = ShaderTelemetry::now();
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    compileMs += ShaderTelemetry::now() - start;
+    compileLog = getShaderInfoLog(shader);
+    if (!success)
+    {
+        std::cout << "ERROR::SHADER::STAGE::COMPILATION_FAILED " << path << "\n" << compileLog << std::endl;
+    }
+    start = ShaderTelemetry::now();
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    stats.linkMs += ShaderTelemetry::now() - start;
+    stats.linkLog = getProgramInfoLog(program);
+    if (!success)
+    {
+        std::cout << "ERROR::PROGRAM::STAGE::LINK_FAILED " << path << "\n" << stats.linkLog << std::endl;
+    }
+
+    // link 之后 shader 对象不再需要
+    glDetachShader(program, shader);
+    glDeleteShader(shader);
+    shader = 0;
+
+    if (success)
+    {
+        ShaderCache::instance().store(cacheKey, program);
+        onLinked();
+    }
+    else
+    {
+        stats.readyMs = ShaderTelemetry::now() - requestTime;
+        state = State::Failed;
+    }
+}
+
+void ShaderStage::onLinked()
+{
+    uniforms.build(program);
+    if (type == GL_VERTEX_SHADER)
+    {
+        reflectShaderAttributes(program, attributes, attributeSignature);
+    }
+    bindUniformBlockSlots(program);
+    state = State::Ready;
+    ShaderProgramStats& stats = ShaderTelemetry::instance().get(telemetryId);
+    stats.linked = true;
+    stats.readyMs = ShaderTelemetry::now() - requestTime;
+}
+
+bool ShaderStage::isReady()
+{
+    if (state == State::Linking)
+    {
+        // 与 Shader::isReady 相同，没有 KHR_parallel_shader_compile 时不阻塞，交给 finishLink 收尾
+        if (!glExtensions.parallelShaderCompile)
+        {
+            return false;
+        }
+        int completed = 0;
+        glGetProgramiv(program, GL_COMPLETION_STATUS_KHR, &completed);
+        if (!completed)
+        {
+            return false;
+        }
+        finishLink();
+    }
+    return state == State::Ready;
+}
+
+GLbitfield ShaderStage::getStageBit() const
+{
+    return type == GL_VERTEX_SHADER ? GL_VERTEX_SHADER_BIT : GL_FRAGMENT_SHADER_BIT;
+}
+
+int ShaderStage::getUniformLocation(HashedString name) const
+{
+    return uniforms.find(name);
+}
+
+void ShaderStage::release()
+{
+    if (shader != 0)
+    {
+        glDeleteShader(shader);
+        shader = 0;
+    }
+    uniforms.clear();
+    GLState::instance().deleteProgram(program);
+    program = 0;
+}
@@ -0,0 +1,159 @@
+#include "ShaderTelemetry.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+    void writeJsonString(std::ostream& out, const std::string& value)
+    {
+        out << '"';
+        for (char c : value)
+        {
+            switch (c)
+            {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\r': out << "\\r"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if ((unsigned char)c < 0x20)
+                {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned int)(unsigned char)c);
+                    out << escaped;
+                }
+                else
+                {
+                    out << c;
+                }
+            }
+        }
+        out << '"';
+    }
+}
+
+ShaderTelemetry& ShaderTelemetry::instance()
+{
+    static ShaderTelemetry telemetry;
+    return telemetry;
+}
+
+double ShaderTelemetry::now()
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+unsigned int ShaderTelemetry::begin(const std::string& name, const std::string& defines)
+{
+    records.emplace_back();
+    records.back().name = name;
+    records.back().defines = defines;
+    return (unsigned int)records.size() - 1;
+}
+
+std::vector<const ShaderProgramStats*> ShaderTelemetry::getSlowest(size_t count) const
+{
+    std::vector<const ShaderProgramStats*> slowest;
+    for (const ShaderProgramStats& record : records)
+    {
+        slowest.push_back(&record);
+    }
+    std::sort(slowest.begin(), slowest.end(), [](const ShaderProgramStats* a, const ShaderProgramStats* b)
+    {
+        return a->getTotalMs() > b->getTotalMs();
+    });
+    if (slowest.size() > count)
+    {
+        slowest.resize(count);
+    }
+    return slowest;
+}
+
+void ShaderTelemetry::printSummary(size_t count) const
+{
+    double total = 0.0;
+    for (const ShaderProgramStats& record : records)
+    {
+        total += record.getTotalMs();
+    }
+    std::cout << "SHADER::TELEMETRY programs: " << records.size() << " total: " << total << " ms" << std::endl;
+    for (const ShaderProgramStats* record : getSlowest(count))
+    {
+        std::cout << "    " << record->getTotalMs() << " ms " << record->name
+            << (record->cacheHit ? " (cache)" : record->spirv ? " (spirv)" : "") << std::endl;
+    }
+}
+
+bool ShaderTelemetry::writeJson(const std::string& path) const
+{
+    std::ofstream out(path, std::ios::trunc);
+    if (!out.is_open())
+    {
+        std::cout << "ERROR::SHADER::TELEMETRY::WRITE_FAILED " << path << std::endl;
+        return false;
+    }
+
+    out << "{\n  \"programs\": [";
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        const ShaderProgramStats& record = records[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\n";
+        out << "      \"name\": ";
+        writeJsonString(out, record.name);
+        out << ",\n      \"defines\": ";
+        writeJsonString(out, record.defines);
+        out << ",\n      \"cacheHit\": " << (record.cacheHit ? "true" : "false")
+            << ",\n      \"spirv\": " << (record.spirv ? "true" : "false")
+            << ",\n      \"spirvFallback\": " << (record.spirvFallback ? "true" : "false")
+            << ",\n      \"linked\": " << (record.linked ? "true" : "false")
+            << ",\n      \"readMs\": " << record.readMs
+            << ",\n      \"vertexCompileMs\": " << record.vertexCompileMs
+            << ",\n      \"fragmentCompileMs\": " << record.fragmentCompileMs
+            << ",\n      \"linkMs\": " << record.linkMs
+            << ",\n      \"readyMs\": " << record.readyMs
+            << ",\n      \"firstUseMs\": " << record.firstUseMs
+            << ",\n      \"totalMs\": " << record.getTotalMs();
+        out << ",\n      \"vertexLog\": ";
+        writeJsonString(out, record.vertexLog);
+        out << ",\n      \"fragmentLog\": ";
+        writeJsonString(out, record.fragmentLog);
+        out << ",\n      \"linkLog\": ";
+        writeJsonString(out, record.linkLog);
+        out << "\n    }";
+    }
+    out << "\n  ]\n}\n";
+    return true;
+}
+
+std::string getShaderInfoLog(unsigned int shader)
+{
+    int length = 0;
+    glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+    if (length <= 1)
+    {
+        return std::string();
+    }
+    std::string log(length, '\0');
+    glGetShaderInfoLog(shader, length, &length, &log[0]);
+    log.resize(length);
+    return log;
+}
+
+std::string getProgramInfoLog(unsigned int program)
+{
+    int length = 0;
+    glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+    if (length <= 1)
+    {
+        return std::string();
+    }
+    std::string log(length, '\0');
+    glGetProgramInfoLog(program, length, &length, &log[0]);
+    log.resize(length);
+    return log;
+}
@@ -0,0 +1,126 @@
+#include "ShaderVariants.h"
+#include "ShaderPreprocessor.h"
+#include <fstream>
+#include <iostream>
+
+ShaderVariants::ShaderVariants(const char* vertexPath, const char* fragmentPath, const std::vector<std::string>& features)
+    : vertexPath(vertexPath), fragmentPath(fragmentPath), features(features)
+{
+    if (features.size() > 32)
+    {
+        std::cout << "ERROR::SHADER::VARIANTS::TOO_MANY_FEATURES " << features.size() << std::endl;
+        this->features.resize(32);
+    }
+
+    // 只保留源码中出现过的 feature，其余的位不会改变编译结果
+    ShaderPreprocessor& preprocessor = ShaderPreprocessor::instance();
+    const std::string& vertexSource = preprocessor.preprocess(this->vertexPath).source;
+    const std::string& fragmentSource = preprocessor.preprocess(this->fragmentPath).source;
+    for (size_t i = 0; i < this->features.size(); ++i)
+    {
+        const std::string& feature = this->features[i];
+        if (vertexSource.find(feature) != std::string::npos || fragmentSource.find(feature) != std::string::npos)
+        {
+            usedMask |= 1u << i;
+        }
+    }
+}
+
+Shader& ShaderVariants::get(uint32_t mask)
+{
+    requested.insert(mask);
+    mask &= usedMask;
+    auto it = variants.find(mask);
+    if (it != variants.end())
+    {
+        return *it->second;
+    }
+    // 只在第一次请求时提交编译，状态等到 isReady 或第一次 use 时再查询
+    Shader* shader = create(mask);
+    batch.submit();
+    return *shader;
+}
+
+void ShaderVariants::prewarm(const std::string& usageLogPath)
+{
+    std::ifstream log(usageLogPath);
+    uint32_t mask = 0;
+    while (log >> std::hex >> mask)
+    {
+        requested.insert(mask);
+        mask &= usedMask;
+        if (variants.count(mask) == 0)
+        {
+            create(mask);
+        }
+    }
+    // 一次性提交，驱动可以并行编译全部变体
+    batch.submit();
+}
+
+void ShaderVariants::saveUsageLog(const std::string& usageLogPath) const
+{
+    std::ofstream log(usageLogPath, std::ios::trunc);
+    if (!log.is_open())
+    {
+        std::cout << "ERROR::SHADER::VARIANTS::USAGE_LOG_WRITE_FAILED " << usageLogPath << std::endl;
+        return;
+    }
+    for (uint32_t mask : requested)
+    {
+        log << std::hex << mask << "\n";
+    }
+}
+
+void ShaderVariants::update()
+{
+    batch.poll();
+    if (hotReload)
+    {
+        // 修改被 include 的文件时所有变体同时重新编译，没有 KHR_parallel_shader_compile 时每帧只阻塞收尾一个
+        bool canFinish = true;
+        for (auto& variant : variants)
+        {
+            if (variant.second->update(canFinish))
+            {
+                canFinish = false;
+            }
+        }
+    }
+}
+
+void ShaderVariants::enableHotReload()
+{
+    hotReload = true;
+    for (auto& variant : variants)
+    {
+        variant.second->enableHotReload();
+    }
+}
+
+void ShaderVariants::release()
+{
+    batch.release();
+    variants.clear();
+}
+
+Shader* ShaderVariants::create(uint32_t mask)
+{
+    Shader* shader = batch.add(vertexPath.c_str(), fragmentPath.c_str(), "", buildConstants(mask));
+    if (hotReload)
+    {
+        shader->enableHotReload();
+    }
+    variants[mask] = shader;
+    return shader;
+}
+
+std::vector<SpecializationConstant> ShaderVariants::buildConstants(uint32_t mask) const
+{
+    std::vector<SpecializationConstant> constants;
+    for (size_t i = 0; i < features.size(); ++i)
+    {
+        constants.push_back(SpecializationConstant{ features[i], (unsigned int)i, (mask & (1u << i)) ? 1 : 0 });
+    }
+    return constants;
+}
@@ -0,0 +1,179 @@
+#include "StreamBuffer.h"
+#include "GLExtensions.h"
+#include "GLState.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace
+{
+    double getTimeMs()
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+StreamBuffer::StreamBuffer(unsigned int frameCapacity, unsigned int frameCount)
+    : frameCount(frameCount)
+{
+    int offsetAlignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+    if (offsetAlignment > 0)
+    {
+        uniformAlignment = (unsigned int)offsetAlignment;
+    }
+    // 每帧区域的起点满足 uniform 的对齐要求，其他对齐都是它的约数
+    this->frameCapacity = (frameCapacity + uniformAlignment - 1) / uniformAlignment * uniformAlignment;
+    fences.assign(frameCount, nullptr);
+
+    // 借用 GL_COPY_WRITE_BUFFER 创建和映射，不影响 VAO 中的索引缓冲绑定
+    GLState& glState = GLState::instance();
+    glGenBuffers(1, &buffer);
+    glState.bindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    GLsizeiptr totalSize = (GLsizeiptr)this->frameCapacity * frameCount;
+    if (glExtensions.bufferStorage)
+    {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_COPY_WRITE_BUFFER, totalSize, NULL, flags);
+        mapped = static_cast<char*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, totalSize, flags));
+        persistent = mapped != nullptr;
+        if (!persistent)
+        {
+            // buffer storage 的大小不能再改变，重新创建一个
+            std::cout << "ERROR::STREAM_BUFFER::PERSISTENT_MAP_FAILED" << std::endl;
+            glState.deleteBuffer(buffer);
+            glGenBuffers(1, &buffer);
+            glState.bindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        }
+    }
+    if (!persistent)
+    {
+        glBufferData(GL_COPY_WRITE_BUFFER, totalSize, NULL, GL_STREAM_DRAW);
+    }
+}
+
+void StreamBuffer::beginFrame()
+{
+    frameIndex = (frameIndex + 1) % frameCount;
+    cursor = 0;
+    flushed = 0;
+    ++frames;
+
+    GLsync& fence = fences[frameIndex];
+    if (fence != nullptr)
+    {
+        // 先不等待地查询一次，只有 GPU 确实还没用完时才计入等待
+        GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        if (result == GL_TIMEOUT_EXPIRED)
+        {
+            double start = getTimeMs();
+            glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+            double elapsed = getTimeMs() - start;
+            ++stalls;
+            waitMs += elapsed;
+            maxWaitMs = std::max(maxWaitMs, elapsed);
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+}
+
+bool StreamBuffer::map()
+{
+    if (mapped != nullptr)
+    {
+        return true;
+    }
+    // 映射本帧剩余的区域；fence 已经保证 GPU 不再读取，不需要驱动同步，旧内容也不需要保留
+    mappedOffset = frameIndex * frameCapacity + cursor;
+    GLState::instance().bindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    mapped = static_cast<char*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, mappedOffset, frameCapacity - cursor,
+        GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT));
+    if (mapped == nullptr)
+    {
+        std::cout << "ERROR::STREAM_BUFFER::MAP_FAILED" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+StreamBufferRange StreamBuffer::allocate(unsigned int size, unsigned int alignment)
+{
+    unsigned int frameStart = frameIndex * frameCapacity;
+    if (size == 0)
+    {
+        return StreamBufferRange{ frameStart + cursor, 0, nullptr };
+    }
+    // 对齐的是整个 buffer 中的偏移而不是帧区域内的偏移：帧区域的起点只按 uniform 对齐，
+    // 不一定是顶点 stride 的倍数，只有这样 offset / stride 才是整数
+    alignment = std::max(alignment, 1u);
+    unsigned int bufferOffset = (frameStart + cursor + alignment - 1) / alignment * alignment;
+    unsigned int offset = bufferOffset - frameStart;
+    if (offset + size > frameCapacity)
+    {
+        std::cout << "ERROR::STREAM_BUFFER::OUT_OF_MEMORY " << size << std::endl;
+        return StreamBufferRange{ frameStart, 0, nullptr };
+    }
+    if (!persistent && !map())
+    {
+        return StreamBufferRange{ frameStart, 0, nullptr };
+    }
+    cursor = offset + size;
+    // 持久映射的指针对应整个 buffer，GL 3.3 的指针对应从 mappedOffset 开始的区间
+    char* data = persistent ? mapped + bufferOffset : mapped + (bufferOffset - mappedOffset);
+    return StreamBufferRange{ bufferOffset, size, data };
+}
+
+void StreamBuffer::flush()
+{
+    if (cursor <= flushed)
+    {
+        return;
+    }
+    uploadedBytes += cursor - flushed;
+    // coherent 映射的写入对之后提交的命令自动可见
+    if (!persistent && mapped != nullptr)
+    {
+        GLState::instance().bindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glFlushMappedBufferRange(GL_COPY_WRITE_BUFFER, 0, frameIndex * frameCapacity + cursor - mappedOffset);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        mapped = nullptr;
+    }
+    flushed = cursor;
+}
+
+void StreamBuffer::endFrame()
+{
+    flush();
+    fences[frameIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void StreamBuffer::release()
+{
+    for (GLsync& fence : fences)
+    {
+        if (fence != nullptr)
+        {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    if (mapped != nullptr)
+    {
+        GLState::instance().bindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        mapped = nullptr;
+    }
+    GLState::instance().deleteBuffer(buffer);
+    buffer = 0;
+}
+
+void StreamBuffer::printStats() const
+{
+    std::cout << "STREAM_BUFFER::STATS mode: " << (persistent ? "persistent" : "unsynchronized")
+        << " frames: " << frames
+        << " uploaded: " << uploadedBytes / 1024.0 << " KB"
+        << " fence stalls: " << stalls
+        << " wait: " << waitMs << " ms"
+        << " max: " << maxWaitMs << " ms" << std::endl;
+}
@@ -0,0 +1,143 @@
+#include "UniformBuffer.h"
+#include "GLState.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+const char* getUniformBlockName(UniformBlockSlot slot)
+{
+    switch (slot)
+    {
+    case UniformBlockSlot::PerFrame: return "PerFrame";
+    case UniformBlockSlot::PerMaterial: return "PerMaterial";
+    case UniformBlockSlot::PerObject: return "PerObject";
+    default: return "";
+    }
+}
+
+void bindUniformBlockSlots(unsigned int program)
+{
+    for (unsigned int slot = 0; slot < (unsigned int)UniformBlockSlot::Count; ++slot)
+    {
+        unsigned int blockIndex = glGetUniformBlockIndex(program, getUniformBlockName((UniformBlockSlot)slot));
+        if (blockIndex != GL_INVALID_INDEX)
+        {
+            glUniformBlockBinding(program, blockIndex, slot);
+        }
+    }
+}
+
+bool UniformBlockLayout::reflect(unsigned int program, const char* blockName)
+{
+    members.clear();
+    names.clear();
+    size = 0;
+
+    unsigned int blockIndex = glGetUniformBlockIndex(program, blockName);
+    if (blockIndex == GL_INVALID_INDEX)
+    {
+        return false;
+    }
+
+    int dataSize = 0;
+    int memberCount = 0;
+    glGetActiveUniformBlockiv(program, blockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &dataSize);
+    glGetActiveUniformBlockiv(program, blockIndex, GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS, &memberCount);
+    if (memberCount <= 0)
+    {
+        return false;
+    }
+
+    std::vector<int> indices(memberCount);
+    glGetActiveUniformBlockiv(program, blockIndex, GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES, indices.data());
+    std::vector<unsigned int> uniformIndices(indices.begin(), indices.end());
+    std::vector<int> offsets(memberCount);
+    std::vector<int> arrayStrides(memberCount);
+    std::vector<int> matrixStrides(memberCount);
+    glGetActiveUniformsiv(program, memberCount, uniformIndices.data(), GL_UNIFORM_OFFSET, offsets.data());
+    glGetActiveUniformsiv(program, memberCount, uniformIndices.data(), GL_UNIFORM_ARRAY_STRIDE, arrayStrides.data());
+    glGetActiveUniformsiv(program, memberCount, uniformIndices.data(), GL_UNIFORM_MATRIX_STRIDE, matrixStrides.data());
+
+    int maxLength = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    std::vector<char> nameBuffer(maxLength > 0 ? maxLength : 1);
+    std::string prefix = std::string(blockName) + ".";
+    for (int i = 0; i < memberCount; ++i)
+    {
+        int length = 0;
+        glGetActiveUniformName(program, uniformIndices[i], (GLsizei)nameBuffer.size(), &length, nameBuffer.data());
+        std::string name(nameBuffer.data(), length);
+        // 数组名形如 "lights[0]"，带实例名的 block 成员形如 "PerFrame.ratio"
+        if (name.size() >= 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
+        {
+            name.resize(name.size() - 3);
+        }
+        if (name.compare(0, prefix.size(), prefix) == 0)
+        {
+            name.erase(0, prefix.size());
+        }
+        members.push_back(Member{ hashString(name.c_str(), name.size()), offsets[i], arrayStrides[i], matrixStrides[i],
+            (uint32_t)names.size(), (uint32_t)name.size() });
+        names.insert(names.end(), name.begin(), name.end());
+    }
+
+    std::sort(members.begin(), members.end(), [](const Member& a, const Member& b) { return a.hash < b.hash; });
+    size = (unsigned int)dataSize;
+    return true;
+}
+
+const UniformBlockLayout::Member* UniformBlockLayout::find(HashedString name) const
+{
+    auto it = std::lower_bound(members.begin(), members.end(), name.hash,
+        [](const Member& member, uint32_t hash) { return member.hash < hash; });
+    // 哈希相同的成员相邻，逐个比较名字，不存在的名字不会因为冲突写到别的成员
+    for (; it != members.end() && it->hash == name.hash; ++it)
+    {
+        if (it->nameLength == name.length && memcmp(names.data() + it->nameOffset, name.name, name.length) == 0)
+        {
+            return &*it;
+        }
+    }
+    return nullptr;
+}
+
+UniformBufferRing::UniformBufferRing(unsigned int frameCapacity, unsigned int frameCount)
+    : stream(frameCapacity, frameCount)
+{
+}
+
+void UniformBufferRing::beginFrame()
+{
+    stream.beginFrame();
+}
+
+UniformBufferRange UniformBufferRing::allocate(unsigned int size)
+{
+    StreamBufferRange range = stream.allocateUniforms(size);
+    return UniformBufferRange{ range.offset, range.size, range.data };
+}
+
+void UniformBufferRing::flush()
+{
+    stream.flush();
+}
+
+void UniformBufferRing::bind(UniformBlockSlot slot, const UniformBufferRange& range)
+{
+    if (range.size == 0)
+    {
+        return;
+    }
+    // 每帧的区间不同，但同一帧内多次绑定同一区间会被状态缓存过滤
+    GLState::instance().bindBufferRange(GL_UNIFORM_BUFFER, (unsigned int)slot, stream.getBuffer(), range.offset, range.size);
+}
+
+void UniformBufferRing::endFrame()
+{
+    stream.endFrame();
+}
+
+void UniformBufferRing::release()
+{
+    stream.release();
+}
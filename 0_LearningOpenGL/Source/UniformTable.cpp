@@ -0,0 +1,126 @@
+#include "UniformTable.h"
+#include <cstring>
+#include <string>
+#include <utility>
+
+void UniformTable::build(unsigned int program)
+{
+    clear();
+
+    int activeCount = 0;
+    int maxLength = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &activeCount);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    if (activeCount <= 0)
+    {
+        return;
+    }
+
+    // 先收集 (名字, location)，数组的每个元素也单独记录，之后再按数量确定表的大小
+    std::vector<std::pair<std::string, int>> entries;
+    std::vector<char> nameBuffer(maxLength > 0 ? maxLength : 1);
+    for (int i = 0; i < activeCount; ++i)
+    {
+        int length = 0;
+        int arraySize = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program, i, (GLsizei)nameBuffer.size(), &length, &arraySize, &type, nameBuffer.data());
+        std::string name(nameBuffer.data(), length);
+
+        // uniform block 中的成员没有 location，由 UBO 负责
+        int location = glGetUniformLocation(program, name.c_str());
+        if (location < 0)
+        {
+            continue;
+        }
+        entries.emplace_back(name, location);
+
+        // 数组的名字形如 "arr[0]"，同时登记 "arr" 以及每个元素 "arr[i]"
+        size_t bracket = name.size() >= 3 ? name.rfind("[0]") : std::string::npos;
+        if (bracket != std::string::npos && bracket == name.size() - 3)
+        {
+            std::string baseName = name.substr(0, bracket);
+            entries.emplace_back(baseName, location);
+            for (int element = 1; element < arraySize; ++element)
+            {
+                std::string elementName = baseName + "[" + std::to_string(element) + "]";
+                int elementLocation = glGetUniformLocation(program, elementName.c_str());
+                if (elementLocation >= 0)
+                {
+                    entries.emplace_back(elementName, elementLocation);
+                }
+            }
+        }
+    }
+
+    // 负载因子不超过 0.5，容量取 2 的幂以便用掩码代替取模
+    size_t capacity = 8;
+    while (capacity < entries.size() * 2)
+    {
+        capacity <<= 1;
+    }
+    slots.assign(capacity, Slot{ 0, -1, 0, 0 });
+    mask = (uint32_t)(capacity - 1);
+
+    for (const auto& entry : entries)
+    {
+        insert(hashString(entry.first.c_str(), entry.first.size()), entry.second, entry.first);
+    }
+}
+
+void UniformTable::clear()
+{
+    slots.clear();
+    names.clear();
+    mask = 0;
+    count = 0;
+}
+
+int UniformTable::find(HashedString name) const
+{
+    if (slots.empty())
+    {
+        return -1;
+    }
+    for (uint32_t index = name.hash & mask; ; index = (index + 1) & mask)
+    {
+        const Slot& slot = slots[index];
+        if (slot.location < 0)
+        {
+            return -1;
+        }
+        // 哈希相同的不同名字继续向后探测
+        if (slot.hash == name.hash && matches(slot, name.name, name.length))
+        {
+            return slot.location;
+        }
+    }
+}
+
+bool UniformTable::matches(const Slot& slot, const char* name, size_t length) const
+{
+    return slot.nameLength == length && memcmp(names.data() + slot.nameOffset, name, length) == 0;
+}
+
+void UniformTable::insert(uint32_t hash, int location, const std::string& name)
+{
+    for (uint32_t index = hash & mask; ; index = (index + 1) & mask)
+    {
+        Slot& slot = slots[index];
+        if (slot.location < 0)
+        {
+            slot.hash = hash;
+            slot.location = location;
+            slot.nameOffset = (uint32_t)names.size();
+            slot.nameLength = (uint32_t)name.size();
+            names.insert(names.end(), name.begin(), name.end());
+            ++count;
+            return;
+        }
+        // 同一个名字只登记一次
+        if (slot.hash == hash && matches(slot, name.c_str(), name.size()))
+        {
+            return;
+        }
+    }
+}
@@ -0,0 +1,280 @@
+#include "VertexArrayCache.h"
+#include "GLExtensions.h"
+#include "GLState.h"
+#include "StringHash.h"
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+    // shader 中输入变量的类型对应的分量数
+    int getComponentCount(GLenum type)
+    {
+        switch (type)
+        {
+        case GL_FLOAT: case GL_INT: case GL_UNSIGNED_INT: return 1;
+        case GL_FLOAT_VEC2: case GL_INT_VEC2: case GL_UNSIGNED_INT_VEC2: return 2;
+        case GL_FLOAT_VEC3: case GL_INT_VEC3: case GL_UNSIGNED_INT_VEC3: return 3;
+        case GL_FLOAT_VEC4: case GL_INT_VEC4: case GL_UNSIGNED_INT_VEC4: return 4;
+        default: return 0;
+        }
+    }
+
+    bool isIntegerInput(GLenum type)
+    {
+        switch (type)
+        {
+        case GL_INT: case GL_INT_VEC2: case GL_INT_VEC3: case GL_INT_VEC4:
+        case GL_UNSIGNED_INT: case GL_UNSIGNED_INT_VEC2: case GL_UNSIGNED_INT_VEC3: case GL_UNSIGNED_INT_VEC4:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // 整数输入（ivec/uvec）必须用 glVertexAttribIPointer，不能做归一化
+    bool usesIntegerPath(const VertexAttribute& attribute)
+    {
+        return !attribute.normalized && attribute.type != GL_FLOAT && attribute.type != GL_HALF_FLOAT
+            && attribute.type != GL_DOUBLE && attribute.type != GL_INT_2_10_10_10_REV && attribute.type != GL_UNSIGNED_INT_2_10_10_10_REV;
+    }
+
+    int findAttribute(const VertexLayout& layout, const char* name)
+    {
+        for (int i = 0; i < layout.count; ++i)
+        {
+            if (strcmp(layout.attributes[i].name, name) == 0)
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    // 格式记录在 VAO 中，与具体的缓冲无关；没有 ARB_vertex_attrib_binding 时格式随 glVertexAttribPointer 一起设置
+    void setAttributeFormats(const VertexLayout& layout, const std::vector<std::pair<int, int>>& bindings, unsigned int bindingIndex)
+    {
+        for (const auto& binding : bindings)
+        {
+            const VertexAttribute& attribute = layout.attributes[binding.first];
+            unsigned int location = (unsigned int)binding.second;
+            glEnableVertexAttribArray(location);
+            if (glExtensions.vertexAttribBinding)
+            {
+                if (usesIntegerPath(attribute))
+                {
+                    glVertexAttribIFormat(location, attribute.components, attribute.type, attribute.offset);
+                }
+                else
+                {
+                    glVertexAttribFormat(location, attribute.components, attribute.type, attribute.normalized, attribute.offset);
+                }
+                glVertexAttribBinding(location, bindingIndex);
+            }
+        }
+    }
+}
+
+VertexArrayCache& VertexArrayCache::instance()
+{
+    static VertexArrayCache cache;
+    return cache;
+}
+
+void VertexArrayCache::bind(const VertexLayout& layout, const Shader& shader, unsigned int vertexBuffer, unsigned int indexBuffer)
+{
+    bind(layout, shader.getAttributes(), shader.getAttributeSignature(), vertexBuffer, indexBuffer);
+}
+
+void VertexArrayCache::bind(const VertexLayout& layout, const ShaderPipeline& pipeline, unsigned int vertexBuffer, unsigned int indexBuffer)
+{
+    bind(layout, pipeline.getAttributes(), pipeline.getAttributeSignature(), vertexBuffer, indexBuffer);
+}
+
+bool VertexArrayCache::Key::operator==(const Key& other) const
+{
+    if (attributes != other.attributes || instanceAttributes != other.instanceAttributes || signature != other.signature
+        || inputs->size() != other.inputs->size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < inputs->size(); ++i)
+    {
+        const ShaderAttribute& a = (*inputs)[i];
+        const ShaderAttribute& b = (*other.inputs)[i];
+        if (a.location != b.location || a.type != b.type || a.name != b.name)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t VertexArrayCache::KeyHash::operator()(const Key& key) const
+{
+    const void* layouts[] = { key.attributes, key.instanceAttributes };
+    return (size_t)hashBytes64(layouts, sizeof(layouts), key.signature);
+}
+
+VertexArrayCache::Entry& VertexArrayCache::find(const VertexLayout& layout, const VertexLayout* instanceLayout,
+    const std::vector<ShaderAttribute>& inputs, uint64_t signature)
+{
+    Key key = { layout.attributes, instanceLayout != nullptr ? instanceLayout->attributes : nullptr, signature, &inputs };
+    auto it = entries.find(key);
+    if (it == entries.end())
+    {
+        Entry entry = create(layout, instanceLayout, inputs);
+        entry.inputs.reset(new std::vector<ShaderAttribute>(inputs));
+        key.inputs = entry.inputs.get();
+        it = entries.emplace(key, std::move(entry)).first;
+    }
+    return it->second;
+}
+
+void VertexArrayCache::bind(const VertexLayout& layout, const std::vector<ShaderAttribute>& inputs, uint64_t signature,
+    unsigned int vertexBuffer, unsigned int indexBuffer)
+{
+    bindBuffers(layout, find(layout, nullptr, inputs, signature), vertexBuffer, indexBuffer);
+}
+
+void VertexArrayCache::bind(const VertexLayout& layout, const VertexLayout& instanceLayout, const Shader& shader,
+    unsigned int vertexBuffer, unsigned int instanceBuffer, unsigned int instanceOffset, unsigned int indexBuffer)
+{
+    Entry& entry = find(layout, &instanceLayout, shader.getAttributes(), shader.getAttributeSignature());
+    bindBuffers(layout, entry, vertexBuffer, indexBuffer);
+    if (entry.instanceBuffer != instanceBuffer || entry.instanceOffset != instanceOffset)
+    {
+        if (glExtensions.vertexAttribBinding)
+        {
+            glBindVertexBuffer(1, instanceBuffer, instanceOffset, instanceLayout.stride);
+        }
+        else
+        {
+            setAttributePointers(instanceLayout, entry.instanceBindings, instanceBuffer, instanceOffset);
+        }
+        entry.instanceBuffer = instanceBuffer;
+        entry.instanceOffset = instanceOffset;
+    }
+}
+
+void VertexArrayCache::bindBuffers(const VertexLayout& layout, Entry& entry, unsigned int vertexBuffer, unsigned int indexBuffer)
+{
+    GLState& glState = GLState::instance();
+    glState.bindVertexArray(entry.vertexArray);
+    if (entry.vertexBuffer != vertexBuffer)
+    {
+        if (glExtensions.vertexAttribBinding)
+        {
+            // 格式已经记录在 VAO 中，切换 mesh 只需要换绑定点上的缓冲
+            glBindVertexBuffer(0, vertexBuffer, 0, layout.stride);
+        }
+        else
+        {
+            setAttributePointers(layout, entry.bindings, vertexBuffer, 0);
+        }
+        entry.vertexBuffer = vertexBuffer;
+    }
+    if (entry.indexBuffer != indexBuffer)
+    {
+        glState.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+        entry.indexBuffer = indexBuffer;
+    }
+}
+
+void VertexArrayCache::invalidateBuffer(unsigned int buffer)
+{
+    for (auto& entry : entries)
+    {
+        Entry& cached = entry.second;
+        if (cached.vertexBuffer == buffer)
+        {
+            cached.vertexBuffer = GLState::kUnknown;
+        }
+        if (cached.indexBuffer == buffer)
+        {
+            cached.indexBuffer = GLState::kUnknown;
+        }
+        if (cached.instanceBuffer == buffer)
+        {
+            cached.instanceBuffer = GLState::kUnknown;
+        }
+    }
+}
+
+void VertexArrayCache::release()
+{
+    for (auto& entry : entries)
+    {
+        GLState::instance().deleteVertexArray(entry.second.vertexArray);
+    }
+    entries.clear();
+}
+
+VertexArrayCache::Entry VertexArrayCache::create(const VertexLayout& layout, const VertexLayout* instanceLayout,
+    const std::vector<ShaderAttribute>& inputs)
+{
+    Entry entry = { 0, 0, 0, 0, 0, {}, {}, nullptr };
+
+    // 按名字把 shader 的每个输入对应到 layout（或实例 layout）中的属性，缺失或分量数不一致时给出错误
+    for (const ShaderAttribute& input : inputs)
+    {
+        int index = findAttribute(layout, input.name.c_str());
+        bool perInstance = false;
+        if (index < 0 && instanceLayout != nullptr)
+        {
+            index = findAttribute(*instanceLayout, input.name.c_str());
+            perInstance = index >= 0;
+        }
+        if (index < 0)
+        {
+            std::cout << "ERROR::VERTEX_LAYOUT::MISSING_ATTRIBUTE " << input.name << std::endl;
+            continue;
+        }
+        const VertexAttribute& attribute = (perInstance ? *instanceLayout : layout).attributes[index];
+        if (getComponentCount(input.type) != attribute.components || isIntegerInput(input.type) != usesIntegerPath(attribute))
+        {
+            std::cout << "ERROR::VERTEX_LAYOUT::TYPE_MISMATCH " << input.name << std::endl;
+        }
+        (perInstance ? entry.instanceBindings : entry.bindings).emplace_back(index, input.location);
+    }
+
+    glGenVertexArrays(1, &entry.vertexArray);
+    GLState::instance().bindVertexArray(entry.vertexArray);
+    setAttributeFormats(layout, entry.bindings, 0);
+    if (instanceLayout != nullptr)
+    {
+        setAttributeFormats(*instanceLayout, entry.instanceBindings, 1);
+        if (glExtensions.vertexAttribBinding)
+        {
+            glVertexBindingDivisor(1, 1);
+        }
+        else
+        {
+            for (const auto& binding : entry.instanceBindings)
+            {
+                glVertexAttribDivisor((unsigned int)binding.second, 1);
+            }
+        }
+    }
+    return entry;
+}
+
+void VertexArrayCache::setAttributePointers(const VertexLayout& layout, const std::vector<std::pair<int, int>>& bindings,
+    unsigned int buffer, unsigned int offset)
+{
+    // glVertexAttribPointer 记录的是调用时绑定的 GL_ARRAY_BUFFER
+    GLState::instance().bindBuffer(GL_ARRAY_BUFFER, buffer);
+    for (const auto& binding : bindings)
+    {
+        const VertexAttribute& attribute = layout.attributes[binding.first];
+        const void* pointer = (const void*)(uintptr_t)(offset + attribute.offset);
+        if (usesIntegerPath(attribute))
+        {
+            glVertexAttribIPointer(binding.second, attribute.components, attribute.type, layout.stride, pointer);
+        }
+        else
+        {
+            glVertexAttribPointer(binding.second, attribute.components, attribute.type, attribute.normalized, layout.stride, pointer);
+        }
+    }
+}
@@ -0,0 +1,202 @@
+#include <glad/glad.h>
+#include "VertexBenchmark.h"
+#include "GLState.h"
+#include "UniformBuffer.h"
+#include "VertexArrayCache.h"
+#include "VertexQuantization.h"
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    const int kGridSize = 1024;
+    // 每帧重复绘制的次数，让顶点拉取的开销远大于其他开销
+    const int kDrawsPerFrame = 8;
+    const int kWarmupFrames = 10;
+    const int kMeasuredFrames = 100;
+
+    // 覆盖整个视口的波浪形网格，法线和颜色随位置变化
+    void buildGrid(std::vector<MeshVertex>& vertices, std::vector<unsigned int>& indices)
+    {
+        vertices.resize((size_t)kGridSize * kGridSize);
+        for (int y = 0; y < kGridSize; ++y)
+        {
+            for (int x = 0; x < kGridSize; ++x)
+            {
+                float u = (float)x / (kGridSize - 1);
+                float v = (float)y / (kGridSize - 1);
+                float height = 0.1f * std::sin(u * 20.0f) * std::cos(v * 20.0f);
+                // 高度对 x = 2u - 1、y = 2v - 1 的偏导数得到法线
+                float dx = std::cos(u * 20.0f) * std::cos(v * 20.0f);
+                float dy = -std::sin(u * 20.0f) * std::sin(v * 20.0f);
+                float length = std::sqrt(dx * dx + dy * dy + 1.0f);
+
+                MeshVertex& vertex = vertices[(size_t)y * kGridSize + x];
+                vertex.position[0] = u * 2.0f - 1.0f;
+                vertex.position[1] = v * 2.0f - 1.0f;
+                vertex.position[2] = height;
+                vertex.normal[0] = -dx / length;
+                vertex.normal[1] = -dy / length;
+                vertex.normal[2] = 1.0f / length;
+                vertex.color[0] = u;
+                vertex.color[1] = v;
+                vertex.color[2] = 1.0f - u;
+            }
+        }
+
+        indices.clear();
+        indices.reserve((size_t)(kGridSize - 1) * (kGridSize - 1) * 6);
+        for (int y = 0; y + 1 < kGridSize; ++y)
+        {
+            for (int x = 0; x + 1 < kGridSize; ++x)
+            {
+                unsigned int corner = (unsigned int)(y * kGridSize + x);
+                indices.push_back(corner);
+                indices.push_back(corner + 1);
+                indices.push_back(corner + kGridSize);
+                indices.push_back(corner + 1);
+                indices.push_back(corner + kGridSize + 1);
+                indices.push_back(corner + kGridSize);
+            }
+        }
+    }
+
+    unsigned int createBuffer(const void* data, size_t size)
+    {
+        unsigned int buffer;
+        glGenBuffers(1, &buffer);
+        // 借用 GL_COPY_WRITE_BUFFER 上传，不影响 VAO 中的索引缓冲绑定
+        GLState::instance().bindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)size, data, GL_STATIC_DRAW);
+        return buffer;
+    }
+
+    struct BenchmarkCase
+    {
+        const char* name;
+        const VertexLayout* layout;
+        ShaderPipeline* pipeline;
+        unsigned int vertexBuffer;
+        size_t vertexBytes;
+        // 量化格式需要在 PerObject 中传入反量化变换
+        const PositionTransform* transform;
+        float maxPositionError;
+    };
+
+    // 输出平均每帧的 GPU 时间和墙钟时间（毫秒）
+    void measure(GLFWwindow* window, const BenchmarkCase& test, unsigned int indexBuffer, GLsizei indexCount,
+        UniformBufferRing& uniformRing, double& gpuMs, double& frameMs)
+    {
+        VertexArrayCache& vertexArrays = VertexArrayCache::instance();
+        UniformBlockLayout perObjectLayout;
+        test.pipeline->use();
+        if (test.transform != nullptr)
+        {
+            // PerObject 只在顶点阶段中使用
+            perObjectLayout.reflect(test.pipeline->getProgram(GL_VERTEX_SHADER), "PerObject");
+        }
+
+        unsigned int query;
+        glGenQueries(1, &query);
+        gpuMs = 0.0;
+        double start = 0.0;
+        for (int frame = 0; frame < kWarmupFrames + kMeasuredFrames; ++frame)
+        {
+            if (frame == kWarmupFrames)
+            {
+                glFinish();
+                start = glfwGetTime();
+            }
+            glClear(GL_COLOR_BUFFER_BIT);
+            uniformRing.beginFrame();
+            if (perObjectLayout.isValid())
+            {
+                UniformBufferRange perObject = uniformRing.allocate(perObjectLayout.getSize());
+                perObjectLayout.set(perObject.data, "positionScale", test.transform->scale);
+                perObjectLayout.set(perObject.data, "positionOffset", test.transform->offset);
+                uniformRing.flush();
+                uniformRing.bind(UniformBlockSlot::PerObject, perObject);
+            }
+
+            test.pipeline->use();
+            vertexArrays.bind(*test.layout, *test.pipeline, test.vertexBuffer, indexBuffer);
+            glBeginQuery(GL_TIME_ELAPSED, query);
+            for (int draw = 0; draw < kDrawsPerFrame; ++draw)
+            {
+                glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
+            }
+            glEndQuery(GL_TIME_ELAPSED);
+            uniformRing.endFrame();
+
+            glfwSwapBuffers(window);
+            glfwPollEvents();
+            if (frame >= kWarmupFrames)
+            {
+                // 测试代码，直接同步等待查询结果
+                GLuint64 elapsed = 0;
+                glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+                gpuMs += elapsed / 1.0e6;
+            }
+        }
+        glFinish();
+        frameMs = (glfwGetTime() - start) * 1000.0 / kMeasuredFrames;
+        gpuMs /= kMeasuredFrames;
+        glDeleteQueries(1, &query);
+    }
+}
+
+void runVertexBenchmark(GLFWwindow* window, ShaderPipeline& floatPipeline, ShaderPipeline& quantizedPipeline)
+{
+    // use 会等待编译完成
+    floatPipeline.use();
+    quantizedPipeline.use();
+    if (floatPipeline.isFailed() || quantizedPipeline.isFailed())
+    {
+        std::cout << "ERROR::BENCHMARK::VERTEX::SHADER_FAILED" << std::endl;
+        return;
+    }
+
+    std::vector<MeshVertex> vertices;
+    std::vector<unsigned int> indices;
+    buildGrid(vertices, indices);
+    QuantizedMesh halfMesh = quantizeMesh(vertices, PositionEncoding::Half);
+    QuantizedMesh fixedMesh = quantizeMesh(vertices, PositionEncoding::Fixed16);
+
+    unsigned int indexBuffer = createBuffer(indices.data(), indices.size() * sizeof(unsigned int));
+    BenchmarkCase cases[] = {
+        { "float", &MeshVertexFormat::layout, &floatPipeline, 0, vertices.size() * sizeof(MeshVertex), nullptr, 0.0f },
+        { "half", &halfMesh.getLayout(), &quantizedPipeline, 0, halfMesh.vertices.size() * sizeof(QuantizedVertex),
+            &halfMesh.transform, halfMesh.maxPositionError },
+        { "fixed16", &fixedMesh.getLayout(), &quantizedPipeline, 0, fixedMesh.vertices.size() * sizeof(QuantizedVertex),
+            &fixedMesh.transform, fixedMesh.maxPositionError },
+    };
+    cases[0].vertexBuffer = createBuffer(vertices.data(), cases[0].vertexBytes);
+    cases[1].vertexBuffer = createBuffer(halfMesh.vertices.data(), cases[1].vertexBytes);
+    cases[2].vertexBuffer = createBuffer(fixedMesh.vertices.data(), cases[2].vertexBytes);
+
+    // 关闭垂直同步，否则帧时间被限制在刷新率
+    glfwSwapInterval(0);
+    UniformBufferRing uniformRing(4 * 1024);
+    std::cout << "BENCHMARK::VERTEX vertices: " << vertices.size() << " triangles: " << indices.size() / 3
+        << " draws/frame: " << kDrawsPerFrame << std::endl;
+    for (const BenchmarkCase& test : cases)
+    {
+        double gpuMs = 0.0;
+        double frameMs = 0.0;
+        measure(window, test, indexBuffer, (GLsizei)indices.size(), uniformRing, gpuMs, frameMs);
+        std::cout << "    " << test.name << " bytes/vertex: " << test.layout->stride
+            << " memory: " << test.vertexBytes / (1024.0 * 1024.0) << " MB"
+            << " gpu: " << gpuMs << " ms frame: " << frameMs << " ms"
+            << " max error: " << test.maxPositionError << std::endl;
+    }
+    glfwSwapInterval(1);
+
+    GLState& glState = GLState::instance();
+    for (const BenchmarkCase& test : cases)
+    {
+        glState.deleteBuffer(test.vertexBuffer);
+    }
+    glState.deleteBuffer(indexBuffer);
+    uniformRing.release();
+}
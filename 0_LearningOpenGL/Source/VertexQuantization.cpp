@@ -0,0 +1,190 @@
+#include "VertexQuantization.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    float clampFloat(float value, float low, float high)
+    {
+        return std::min(std::max(value, low), high);
+    }
+
+    uint32_t packSnorm10(float value)
+    {
+        int32_t quantized = (int32_t)std::lround(clampFloat(value, -1.0f, 1.0f) * 511.0f);
+        return (uint32_t)quantized & 0x3FF;
+    }
+
+    uint32_t packSnorm2(float value)
+    {
+        int32_t quantized = (int32_t)std::lround(clampFloat(value, -1.0f, 1.0f));
+        return (uint32_t)quantized & 0x3;
+    }
+
+    float unpackUnorm16(uint16_t value)
+    {
+        return value / 65535.0f;
+    }
+}
+
+const VertexLayout& QuantizedMesh::getLayout() const
+{
+    return encoding == PositionEncoding::Half ? QuantizedHalfFormat::layout : QuantizedFixedFormat::layout;
+}
+
+QuantizedMesh quantizeMesh(const std::vector<MeshVertex>& vertices, PositionEncoding encoding)
+{
+    QuantizedMesh mesh;
+    mesh.encoding = encoding;
+
+    // 包围盒
+    float low[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float high[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (const MeshVertex& vertex : vertices)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            low[i] = std::min(low[i], vertex.position[i]);
+            high[i] = std::max(high[i], vertex.position[i]);
+        }
+    }
+    if (vertices.empty())
+    {
+        std::fill(low, low + 3, 0.0f);
+        std::fill(high, high + 3, 0.0f);
+    }
+
+    // 编码后的值域：Half 为 [-1, 1]，Fixed16 为 [0, 1]；退化的轴 scale 取 1，避免除以 0
+    float scale[3];
+    float offset[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        float extent = high[i] - low[i];
+        if (encoding == PositionEncoding::Half)
+        {
+            scale[i] = extent > 0.0f ? extent * 0.5f : 1.0f;
+            offset[i] = (low[i] + high[i]) * 0.5f;
+        }
+        else
+        {
+            scale[i] = extent > 0.0f ? extent : 1.0f;
+            offset[i] = low[i];
+        }
+    }
+    mesh.transform.scale = { scale[0], scale[1], scale[2], 1.0f };
+    mesh.transform.offset = { offset[0], offset[1], offset[2], 0.0f };
+
+    mesh.vertices.resize(vertices.size());
+    for (size_t v = 0; v < vertices.size(); ++v)
+    {
+        const MeshVertex& source = vertices[v];
+        QuantizedVertex& target = mesh.vertices[v];
+        for (int i = 0; i < 3; ++i)
+        {
+            float normalized = (source.position[i] - offset[i]) / scale[i];
+            float decoded;
+            if (encoding == PositionEncoding::Half)
+            {
+                target.position[i] = floatToHalf(normalized);
+                decoded = halfToFloat(target.position[i]);
+            }
+            else
+            {
+                target.position[i] = packUnorm16(normalized);
+                decoded = unpackUnorm16(target.position[i]);
+            }
+            mesh.maxPositionError = std::max(mesh.maxPositionError, std::fabs(decoded * scale[i] + offset[i] - source.position[i]));
+        }
+        // w 只用于补齐，shader 中不使用
+        target.position[3] = encoding == PositionEncoding::Half ? floatToHalf(1.0f) : 65535;
+
+        target.normal = packSnorm10_10_10_2(source.normal[0], source.normal[1], source.normal[2], 0.0f);
+        for (int i = 0; i < 3; ++i)
+        {
+            target.color[i] = packUnorm8(source.color[i]);
+        }
+        target.color[3] = 255;
+    }
+    return mesh;
+}
+
+uint16_t floatToHalf(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000;
+    uint32_t exponent = (bits >> 23) & 0xFF;
+    uint32_t mantissa = bits & 0x7FFFFF;
+
+    // 无穷大和 NaN
+    if (exponent == 0xFF)
+    {
+        return (uint16_t)(sign | 0x7C00 | (mantissa != 0 ? 0x200 : 0));
+    }
+    int halfExponent = (int)exponent - 127 + 15;
+    if (halfExponent >= 31)
+    {
+        return (uint16_t)(sign | 0x7C00);
+    }
+    // 非规格化数：补上隐含的 1 之后右移
+    if (halfExponent <= 0)
+    {
+        if (halfExponent < -10)
+        {
+            return (uint16_t)sign;
+        }
+        mantissa |= 0x800000;
+        uint32_t shift = (uint32_t)(14 - halfExponent);
+        uint32_t half = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1) != 0))
+        {
+            ++half;
+        }
+        return (uint16_t)(sign | half);
+    }
+    // 舍入进位会自然地进到指数位，最大值之上变为无穷大
+    uint32_t half = ((uint32_t)halfExponent << 10) | (mantissa >> 13);
+    uint32_t remainder = mantissa & 0x1FFF;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1) != 0))
+    {
+        ++half;
+    }
+    return (uint16_t)(sign | half);
+}
+
+float halfToFloat(uint16_t value)
+{
+    uint32_t sign = (uint32_t)(value & 0x8000) << 16;
+    uint32_t exponent = (value >> 10) & 0x1F;
+    uint32_t mantissa = value & 0x3FF;
+    if (exponent == 0)
+    {
+        float magnitude = std::ldexp((float)mantissa, -24);
+        return sign != 0 ? -magnitude : magnitude;
+    }
+    uint32_t bits = exponent == 31
+        ? sign | 0x7F800000 | (mantissa << 13)
+        : sign | ((exponent + 112) << 23) | (mantissa << 13);
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+uint8_t packUnorm8(float value)
+{
+    return (uint8_t)std::lround(clampFloat(value, 0.0f, 1.0f) * 255.0f);
+}
+
+uint16_t packUnorm16(float value)
+{
+    return (uint16_t)std::lround(clampFloat(value, 0.0f, 1.0f) * 65535.0f);
+}
+
+uint32_t packSnorm10_10_10_2(float x, float y, float z, float w)
+{
+    return packSnorm10(x) | (packSnorm10(y) << 10) | (packSnorm10(z) << 20) | (packSnorm2(w) << 30);
+}
@@ -0,0 +1,116 @@
+"""
+离线把 Shader/ 下的 .vert/.frag 编译成 OpenGL SPIR-V（<文件名>.spv），供 ARB_gl_spirv 路径加载
+
+用法：python Tools/CompileSpirv.py [glslangValidator 路径]
+- #include "file" 与运行时的 ShaderPreprocessor 相同：路径相对于当前文件，支持 #pragma once
+- 只有 include 闭包中有文件比 .spv 新时才重新编译
+- 找不到 glslangValidator 时只给出提示，运行时会回退到 GLSL 源码
+"""
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SHADER_DIR = os.path.join(PROJECT_DIR, "Shader")
+STAGES = {".vert": "vert", ".frag": "frag"}
+INCLUDE_PATTERN = re.compile(r'^\s*#\s*include\s+"([^"]+)"')
+# 与 ShaderPreprocessor::isPragmaOnce 相同，只匹配指令本身，注释中的 "#pragma once" 不算
+PRAGMA_ONCE_PATTERN = re.compile(r'^\s*#\s*pragma\s+once\b')
+
+
+def expand(path, files, stack, once_files, out):
+    path = os.path.normpath(path)
+    if path in once_files:
+        return
+    if path in stack:
+        raise RuntimeError("include cycle: " + path)
+    with open(path, "r", encoding="utf-8") as f:
+        content = f.read()
+    # 与 std::getline 一致，结尾的换行不产生空行
+    lines = content.split("\n")
+    if content.endswith("\n"):
+        lines.pop()
+    if any(PRAGMA_ONCE_PATTERN.match(line) for line in lines):
+        once_files.add(path)
+    if path not in files:
+        files.append(path)
+    file_index = files.index(path)
+    # 与运行时一致，根文件第一行是 #version，不能插入 #line
+    if stack:
+        out.append("#line 1 %d" % file_index)
+
+    stack.append(path)
+    for number, line in enumerate(lines, 1):
+        match = INCLUDE_PATTERN.match(line)
+        if match:
+            expand(os.path.join(os.path.dirname(path), match.group(1)), files, stack, once_files, out)
+            out.append("#line %d %d" % (number + 1, file_index))
+        elif PRAGMA_ONCE_PATTERN.match(line):
+            out.append("")
+        else:
+            out.append(line)
+    stack.pop()
+
+
+def expand_source(path):
+    """展开 include，结果与运行时 ShaderPreprocessor::Unit::source 逐字节相同，返回 (源码, include 闭包)"""
+    files = []
+    out = []
+    expand(path, files, [], set(), out)
+    return "".join(line + "\n" for line in out), files
+
+
+def hash_source(source):
+    """与 StringHash.h 中的 hashBytes64 相同（FNV-1a 64）"""
+    value = 14695981039346656037
+    for byte in source.encode("utf-8"):
+        value = ((value ^ byte) * 1099511628211) & 0xFFFFFFFFFFFFFFFF
+    return value
+
+
+def compile_shader(validator, path, stage):
+    source, files = expand_source(path)
+
+    target = path + ".spv"
+    if os.path.exists(target) and all(os.path.getmtime(f) <= os.path.getmtime(target) for f in files):
+        return True
+
+    # -G：OpenGL 语义的 SPIR-V；GLSL 中没有写 location/binding 的变量自动分配
+    handle, expanded = tempfile.mkstemp(suffix="." + stage)
+    with os.fdopen(handle, "w", encoding="utf-8") as f:
+        f.write(source)
+    try:
+        result = subprocess.run([validator, "-G", "--auto-map-locations", "--auto-map-bindings",
+                                 "-S", stage, "-o", target, expanded],
+                                stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    finally:
+        os.remove(expanded)
+    if result.returncode != 0:
+        print("ERROR::SPIRV::COMPILATION_FAILED " + os.path.relpath(path, PROJECT_DIR))
+        print(result.stdout)
+        if os.path.exists(target):
+            os.remove(target)
+        return False
+    print("SPIRV " + os.path.relpath(target, PROJECT_DIR))
+    return True
+
+
+def main():
+    validator = sys.argv[1] if len(sys.argv) > 1 else shutil.which("glslangValidator")
+    if validator is None:
+        print("SPIRV::SKIPPED glslangValidator not found, shaders will be compiled from GLSL at runtime")
+        return 0
+
+    success = True
+    for name in sorted(os.listdir(SHADER_DIR)):
+        stage = STAGES.get(os.path.splitext(name)[1])
+        if stage is not None:
+            success = compile_shader(validator, os.path.join(SHADER_DIR, name), stage) and success
+    return 0 if success else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
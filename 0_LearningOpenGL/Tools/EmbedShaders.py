@@ -0,0 +1,106 @@
+"""
+把 Shader/ 下的 shader 源码嵌入可执行文件，生成 Include/EmbeddedShaders.h 与 Source/EmbeddedShaders.cpp
+
+用法：python Tools/EmbedShaders.py [--binaries]
+- 默认只嵌入源码（.vert/.frag/.glsl），生成的文件只随源码变化，可以直接提交
+- --binaries 同时嵌入 CompileSpirv.py / OptimizeShaders.py 的输出（.spv 与 Optimized/），用于发布构建：
+  Release 的预生成步骤在 OptimizeShaders 和 CompileSpirv 之后带 --binaries 运行，从嵌入路径加载时也能用上这两条路径
+- 内容没有变化时不改写文件，避免触发重新编译
+"""
+import os
+import re
+import sys
+
+PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SHADER_DIR = os.path.join(PROJECT_DIR, "Shader")
+HEADER_PATH = os.path.join(PROJECT_DIR, "Include", "EmbeddedShaders.h")
+SOURCE_PATH = os.path.join(PROJECT_DIR, "Source", "EmbeddedShaders.cpp")
+SOURCE_EXTENSIONS = (".vert", ".frag", ".glsl")
+BINARY_EXTENSIONS = (".spv",)
+GENERATED_NOTICE = "// 由 Tools/EmbedShaders.py 根据 Shader/ 目录生成，不要手动修改\n"
+
+
+def collect(binaries):
+    files = []
+    for directory, subdirectories, names in os.walk(SHADER_DIR):
+        subdirectories.sort()
+        relative = os.path.relpath(directory, SHADER_DIR)
+        if not binaries and relative.split(os.sep)[0] == "Optimized":
+            continue
+        for name in sorted(names):
+            extension = os.path.splitext(name)[1]
+            if extension in SOURCE_EXTENSIONS or (binaries and extension in BINARY_EXTENSIONS):
+                path = os.path.join(directory, name)
+                files.append(os.path.relpath(path, PROJECT_DIR).replace(os.sep, "/"))
+    return files
+
+
+def identifier(path):
+    # "Shader/Optimized/VertexShader.vert" -> "Optimized_VertexShader_vert"
+    return re.sub(r"\W", "_", path[len("Shader/"):])
+
+
+def read_data(path):
+    with open(os.path.join(PROJECT_DIR, path), "rb") as f:
+        data = f.read()
+    # 与运行时以文本方式读取一致，源码统一为 \n 换行
+    if not path.endswith(BINARY_EXTENSIONS):
+        data = data.replace(b"\r\n", b"\n")
+    return data
+
+
+def generate(files):
+    header = [GENERATED_NOTICE, "#pragma once\n", "\n", "#include <cstddef>\n", "#include \"EmbeddedFiles.h\"\n", "\n",
+              "namespace EmbeddedShaders\n", "{\n"]
+    for path in files:
+        header.append("    extern const EmbeddedFile %s;\n" % identifier(path))
+    header += ["}\n", "\n",
+               "// 全部嵌入的文件，供 findEmbeddedFile 按路径查找\n",
+               "extern const EmbeddedFile* const kEmbeddedFiles[];\n",
+               "extern const size_t kEmbeddedFileCount;\n"]
+
+    source = [GENERATED_NOTICE, "#include \"EmbeddedShaders.h\"\n", "\n", "namespace\n", "{\n"]
+    for path in files:
+        data = read_data(path)
+        source.append("    // %s\n" % path)
+        source.append("    constexpr char k%s[] = {\n" % identifier(path))
+        # 用字符字面量，大于 0x7F 的字节不会触发窄化转换；空文件也需要一个元素，大小单独记录
+        values = ["'\\x%02x'" % byte for byte in data] or ["'\\0'"]
+        for i in range(0, len(values), 16):
+            source.append("        " + ", ".join(values[i:i + 16]) + ",\n")
+        source.append("    };\n")
+        source.append("    constexpr size_t k%sSize = %d;\n" % (identifier(path), len(data)))
+    source += ["}\n", "\n", "namespace EmbeddedShaders\n", "{\n"]
+    for path in files:
+        name = identifier(path)
+        source.append("    constexpr EmbeddedFile %s = { \"%s\", k%s, k%sSize };\n"
+                      % (name, path, name, name))
+    source += ["}\n", "\n", "constexpr const EmbeddedFile* kEmbeddedFiles[] = {\n"]
+    for path in files:
+        source.append("    &EmbeddedShaders::%s,\n" % identifier(path))
+    if not files:
+        source.append("    nullptr,\n")
+    source += ["};\n", "constexpr size_t kEmbeddedFileCount = %d;\n" % len(files)]
+    return "".join(header), "".join(source)
+
+
+def write_if_changed(path, content):
+    if os.path.exists(path):
+        with open(path, "r", encoding="utf-8") as f:
+            if f.read() == content:
+                return
+    with open(path, "w", encoding="utf-8", newline="\n") as f:
+        f.write(content)
+    print("EMBED " + os.path.relpath(path, PROJECT_DIR))
+
+
+def main():
+    files = collect("--binaries" in sys.argv[1:])
+    header, source = generate(files)
+    write_if_changed(HEADER_PATH, header)
+    write_if_changed(SOURCE_PATH, source)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
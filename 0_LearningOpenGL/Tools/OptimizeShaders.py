@@ -0,0 +1,165 @@
+"""
+离线优化 Shader/ 下的所有 .vert/.frag，结果写入 Shader/Optimized/，运行时优先加载
+
+用法：python Tools/OptimizeShaders.py
+流程：展开 include -> glslangValidator -G 编译为 SPIR-V -> spirv-opt -O -> spirv-cross 转回 GLSL 330
+- 死代码、常量折叠、未使用的 uniform 由 spirv-opt 去掉
+- 没有任何片段着色器读取的顶点输出（varying）先降级为普通全局变量，随后被当作死代码删除
+- 输出 <文件名>（GLSL）和 <文件名>.spv，GLSL 第二行记录原始源码展开后的哈希，源码修改后运行时自动忽略过期的结果
+- 报告每个 shader 优化前后的指令数，同时写入 Shader/Optimized/Report.txt
+缺少任意一个工具时只给出提示，运行时使用原始源码
+"""
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from CompileSpirv import PROJECT_DIR, SHADER_DIR, STAGES, expand_source, hash_source  # noqa: E402
+
+OUTPUT_DIR = os.path.join(SHADER_DIR, "Optimized")
+OUT_PATTERN = re.compile(r"^(\s*(?:layout\s*\([^)]*\)\s*)?)out\s+(\w+)\s+(\w+)\s*;", re.M)
+IN_PATTERN = re.compile(r"^\s*(?:layout\s*\([^)]*\)\s*)?in\s+\w+\s+(\w+)\s*;", re.M)
+
+OP_FUNCTION = 54
+OP_FUNCTION_END = 56
+
+
+def count_instructions(spirv):
+    """返回 (全部指令数, 函数体内的指令数)"""
+    words = [int.from_bytes(spirv[i:i + 4], "little") for i in range(0, len(spirv) - len(spirv) % 4, 4)]
+    total = 0
+    body = 0
+    in_function = False
+    i = 5
+    while i < len(words):
+        word_count = words[i] >> 16
+        opcode = words[i] & 0xFFFF
+        if word_count == 0:
+            break
+        total += 1
+        if opcode == OP_FUNCTION:
+            in_function = True
+        elif opcode == OP_FUNCTION_END:
+            in_function = False
+        elif in_function:
+            body += 1
+        i += word_count
+    return total, body
+
+
+def demote_unused_outputs(source, used_inputs):
+    """把没有片段着色器读取的顶点输出改成全局变量，spirv-opt 会删除对它们的写入"""
+    def replace(match):
+        if match.group(3) in used_inputs:
+            return match.group(0)
+        return "%s %s;" % (match.group(2), match.group(3))
+    return OUT_PATTERN.sub(replace, source)
+
+
+def restore_glsl330(source, stage):
+    """spirv-cross 的输出按 GL SPIR-V 的规则带有 location 和实例名，改回 GLSL 330 与运行时反射能用的形式"""
+    # 特化常量：SPIRV_CROSS_CONSTANT_ID_N 换回原名，运行时的 "#define NAME VALUE" 仍然有效
+    constants = dict(re.findall(r"^const \w+ (\w+) = SPIRV_CROSS_CONSTANT_ID_(\d+);\n", source, re.M))
+    for name, constant_id in constants.items():
+        source = re.sub(r"^const \w+ %s = SPIRV_CROSS_CONSTANT_ID_%s;\n" % (name, constant_id), "", source, flags=re.M)
+        source = source.replace("SPIRV_CROSS_CONSTANT_ID_%s" % constant_id, name)
+
+    # varying 与普通 uniform 的 location 在 330 中不可用，按名字匹配
+    varying = "out" if stage == "vert" else "in"
+    source = re.sub(r"^layout\(location = \d+\) (%s|uniform) " % varying, r"\1 ", source, flags=re.M)
+    source = re.sub(r"^#extension GL_ARB_separate_shader_objects : require\n", "", source, flags=re.M)
+
+    # uniform block 恢复为匿名实例，成员名与原始源码一致
+    for instance in re.findall(r"^\} (_\d+);$", source, re.M):
+        source = re.sub(r"^\} %s;$" % instance, "};", source, flags=re.M)
+        source = re.sub(r"\b%s\." % instance, "", source)
+    return source
+
+
+def run(command):
+    return subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+
+
+def optimize_shader(tools, path, stage, used_inputs, report):
+    name = os.path.basename(path)
+    source, _ = expand_source(path)
+    source_hash = hash_source(source)
+    if stage == "vert":
+        source = demote_unused_outputs(source, used_inputs)
+
+    work_dir = tempfile.mkdtemp()
+    try:
+        expanded = os.path.join(work_dir, name)
+        raw = expanded + ".raw.spv"
+        optimized = expanded + ".opt.spv"
+        with open(expanded, "w", encoding="utf-8") as f:
+            f.write(source)
+
+        steps = [
+            [tools["glslangValidator"], "-G", "--auto-map-locations", "--auto-map-bindings", "-S", stage, "-o", raw, expanded],
+            [tools["spirv-opt"], "-O", raw, "-o", optimized],
+            [tools["spirv-cross"], optimized, "--version", "330", "--no-es", "--no-420pack-extension",
+             "--output", expanded + ".glsl"],
+        ]
+        for step in steps:
+            result = run(step)
+            if result.returncode != 0:
+                print("ERROR::SHADER::OPTIMIZE_FAILED " + os.path.relpath(path, PROJECT_DIR))
+                print(result.stdout)
+                return False
+
+        with open(raw, "rb") as f:
+            before = count_instructions(f.read())
+        with open(optimized, "rb") as f:
+            after = count_instructions(f.read())
+        with open(expanded + ".glsl", "r", encoding="utf-8") as f:
+            glsl = restore_glsl330(f.read(), stage)
+
+        # 哈希放在 #version 之后，#version 之前只能有注释和空白，运行时按第二行读取
+        version_end = glsl.index("\n") + 1
+        glsl = glsl[:version_end] + "// source-hash: %016x\n" % source_hash + glsl[version_end:]
+        with open(os.path.join(OUTPUT_DIR, name), "w", encoding="utf-8", newline="\n") as f:
+            f.write(glsl)
+        shutil.copyfile(optimized, os.path.join(OUTPUT_DIR, name + ".spv"))
+    finally:
+        shutil.rmtree(work_dir, ignore_errors=True)
+
+    report.append("%-28s %8d %8d %8d %8d %7.1f%%" % (name, before[0], after[0], before[1], after[1],
+                                                 100.0 * (after[1] - before[1]) / max(before[1], 1)))
+    return True
+
+
+def main():
+    tools = {}
+    for tool in ("glslangValidator", "spirv-opt", "spirv-cross"):
+        tools[tool] = shutil.which(tool)
+        if tools[tool] is None:
+            print("SHADER::OPTIMIZE::SKIPPED %s not found, shaders will be loaded from source" % tool)
+            return 0
+    if not os.path.isdir(OUTPUT_DIR):
+        os.makedirs(OUTPUT_DIR)
+
+    sources = [name for name in sorted(os.listdir(SHADER_DIR)) if os.path.splitext(name)[1] in STAGES]
+    # 任意一个顶点着色器都可能与任意一个片段着色器组合，只有所有片段着色器都不读的输出才能去掉
+    used_inputs = set()
+    for name in sources:
+        if name.endswith(".frag"):
+            used_inputs.update(IN_PATTERN.findall(expand_source(os.path.join(SHADER_DIR, name))[0]))
+
+    report = ["%-28s %8s %8s %8s %8s %8s" % ("shader", "total", "total'", "body", "body'", "delta")]
+    success = True
+    for name in sources:
+        stage = STAGES[os.path.splitext(name)[1]]
+        success = optimize_shader(tools, os.path.join(SHADER_DIR, name), stage, used_inputs, report) and success
+
+    with open(os.path.join(OUTPUT_DIR, "Report.txt"), "w", encoding="utf-8") as f:
+        f.write("\n".join(report) + "\n")
+    print("\n".join(report))
+    return 0 if success else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())